@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+# Compare the cost of including mantissa.h from this tree against the
+# one from an older revision (by default, the first commit): the time to
+# compile a small translation unit that uses binary32 arithmetic, the
+# amount of preprocessed lines, and the size of the object file.
+#
+# Usage: bench/build_time.sh [revision] [runs]
+set -e
+
+source_dir=$(cd "$(dirname "$0")/.." && pwd)
+revision=${1:-$(git -C "$source_dir" rev-list --max-parents=0 HEAD)}
+runs=${2:-10}
+compiler=${CXX:-c++}
+
+work_dir=$(mktemp -d)
+trap 'rm -rf "$work_dir"' EXIT
+mkdir "$work_dir/old"
+git -C "$source_dir" show "$revision:src/mantissa.h" > "$work_dir/old/mantissa.h"
+cat > "$work_dir/unit.cpp" <<'UNIT'
+#include <mantissa.h>
+
+float multiply_add(float a, float b) {
+    binary32 x{a};
+    binary32 y{b};
+    return float(x * y + x - y);
+}
+UNIT
+
+measure() {
+    local name=$1
+    local include_dir=$2
+    local flags=(-std=c++17 -O2 -I"$include_dir")
+    local lines
+    lines=$("$compiler" "${flags[@]}" -E "$work_dir/unit.cpp" | wc -l)
+    local seconds
+    seconds=$( { TIMEFORMAT=%R; time for ((i = 0; i < runs; ++i)); do
+        "$compiler" "${flags[@]}" -c "$work_dir/unit.cpp" -o "$work_dir/unit.o"
+    done; } 2>&1 )
+    local size
+    size=$(wc -c < "$work_dir/unit.o")
+    awk -v name="$name" -v total="$seconds" -v runs="$runs" -v lines="$lines" -v size="$size" \
+        'BEGIN { printf "%-12s %6.3f s per compile, %6d preprocessed lines, %6d byte object\n", name, total / runs, lines, size }'
+}
+
+echo "Including mantissa.h with $compiler, mean of $runs compiles:"
+measure "${revision:0:10}" "$work_dir/old"
+measure "this tree" "$source_dir/src"
@@ -0,0 +1,36 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <mantissa_superaccumulator.h>
+
+/// Time an exact binary32 dot product against a naive hardware float
+/// loop over the same values.
+int main() {
+    static constexpr size_t count = size_t(1) << 22;
+    std::vector<binary32> lhs(count);
+    std::vector<binary32> rhs(count);
+    std::vector<float> lhs_hardware(count);
+    std::vector<float> rhs_hardware(count);
+    CounterRNG rng{32};
+    for (size_t i = 0; i < count; ++i) {
+        u64 bits = rng(i);
+        lhs[i] = binary32{u32((bits & 0x807fffff) | 0x3f000000)};
+        rhs[i] = binary32{u32(((bits >> 32) & 0x807fffff) | 0x3f000000)};
+        lhs_hardware[i] = float(lhs[i]);
+        rhs_hardware[i] = float(rhs[i]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    binary32 exact = exact_dot(lhs.data(), rhs.data(), count);
+    std::chrono::duration<double, std::milli> exact_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    float naive = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+        naive += lhs_hardware[i] * rhs_hardware[i];
+    std::chrono::duration<double, std::milli> naive_time = std::chrono::steady_clock::now() - start;
+
+    std::printf("exact_dot  %8.1f ms  (%a)\n", exact_time.count(), double(float(exact)));
+    std::printf("naive      %8.1f ms  (%a)\n", naive_time.count(), double(naive));
+}
@@ -0,0 +1,42 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <mantissa_expr.h>
+
+/// Time `a*b + c*d - e` over random binary32 operands, rounding every
+/// operation, as a fused expression, and as a strict expression.
+int main() {
+    static constexpr size_t count = size_t(1) << 22;
+    std::vector<binary32> operands(5 * count);
+    std::vector<binary32> results(count);
+    CounterRNG rng{3};
+    for (size_t i = 0; i < operands.size(); ++i)
+        operands[i] = binary32{u32((rng(i) & 0x807fffff) | 0x3f000000)};
+
+    auto time = [&](const char* name, auto compute) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+            results[i] = compute(&operands[5 * i]);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        u32 checksum = 0;
+        for (auto result : results) checksum ^= result.representation;
+        std::printf("%-10s %8.1f ms  (checksum %08x)\n", name, elapsed.count(), checksum);
+    };
+
+    time("per-op", [](const binary32* in) {
+        binary32 ab = in[0];
+        binary32 cd = in[2];
+        ab.mul(in[1], RoundingMode::NearestEven);
+        cd.mul(in[3], RoundingMode::NearestEven);
+        ab.add(cd, RoundingMode::NearestEven);
+        ab.sub(in[4], RoundingMode::NearestEven);
+        return ab;
+    });
+    time("fused", [](const binary32* in) {
+        return binary32(lazy(in[0]) * in[1] + lazy(in[2]) * in[3] - in[4]);
+    });
+    time("strict", [](const binary32* in) {
+        return binary32(lazy_strict(in[0]) * in[1] + lazy_strict(in[2]) * in[3] - in[4]);
+    });
+}
@@ -1,14 +1,14 @@
 #include <iostream>
-#include <mantissa.h>
+#include <mantissa_format.h>
 
 int main() {
     {
         binary32 foo{2.1f};
         binary32 bar{2.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 sum = foo + bar;
-        std::cout << "sum: " << sum.ascii_scientific() << '\n';
+        std::cout << "sum: " << ascii_scientific(sum) << '\n';
 
         float fsum = sum;
         std:: cout << "sum: " << fsum << '\n';
@@ -16,10 +16,10 @@ int main() {
     {
         binary32 foo{2.1f};
         binary32 bar{8.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 sum = foo + bar;
-        std::cout << "sum: " << sum.ascii_scientific() << '\n';
+        std::cout << "sum: " << ascii_scientific(sum) << '\n';
 
         float fsum = sum;
         std:: cout << "sum: " << fsum << '\n';
@@ -27,10 +27,10 @@ int main() {
     {
         binary32 foo{-2.4f};
         binary32 bar{-2.6f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 sum = foo + bar;
-        std::cout << "sum: " << sum.ascii_scientific() << '\n';
+        std::cout << "sum: " << ascii_scientific(sum) << '\n';
 
         float fsum = sum;
         std::cout << "sum: " << fsum << '\n';
@@ -38,10 +38,10 @@ int main() {
     {
         binary32 foo{4.2f};
         binary32 bar{-2.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 sum = foo + bar;
-        std::cout << "sum: " << sum.ascii_scientific() << '\n';
+        std::cout << "sum: " << ascii_scientific(sum) << '\n';
 
         float fsum = sum;
         std::cout << "sum: " << fsum << '\n';
@@ -50,10 +50,10 @@ int main() {
     {
         binary32 foo{4.2f};
         binary32 bar{2.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 diff = foo - bar;
-        std::cout << "diff: " << diff.ascii_scientific() << '\n';
+        std::cout << "diff: " << ascii_scientific(diff) << '\n';
 
         float fdiff = diff;
         std::cout << "diff: " << fdiff << '\n';
@@ -61,10 +61,10 @@ int main() {
     {
         binary32 foo{2.1f};
         binary32 bar{-2.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 diff = foo - bar;
-        std::cout << "diff: " << diff.ascii_scientific() << '\n';
+        std::cout << "diff: " << ascii_scientific(diff) << '\n';
 
         float fdiff = diff;
         std::cout << "diff: " << fdiff << '\n';
@@ -72,10 +72,10 @@ int main() {
     {
         binary32 foo{-2.1f};
         binary32 bar{2.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 diff = foo - bar;
-        std::cout << "diff: " << diff.ascii_scientific() << '\n';
+        std::cout << "diff: " << ascii_scientific(diff) << '\n';
 
         float fdiff = diff;
         std::cout << "diff: " << fdiff << '\n';
@@ -83,10 +83,10 @@ int main() {
     {
         binary32 foo{-4.2f};
         binary32 bar{-2.1f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 diff = foo - bar;
-        std::cout << "diff: " << diff.ascii_scientific() << '\n';
+        std::cout << "diff: " << ascii_scientific(diff) << '\n';
 
         float fdiff = diff;
         std::cout << "diff: " << fdiff << '\n';
@@ -96,10 +96,10 @@ int main() {
     {
         binary32 foo{4.20f};
         binary32 bar{10.0f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 product = foo * bar;
-        std::cout << "product: " << product.ascii_scientific() << '\n';
+        std::cout << "product: " << ascii_scientific(product) << '\n';
 
         float fproduct = product;
         std::cout << "product: " << fproduct << '\n';
@@ -111,10 +111,10 @@ int main() {
     {
         binary32 foo{-18.0f};
         binary32 bar{9.5f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 product = foo * bar;
-        std::cout << "product: " << product.ascii_scientific() << '\n';
+        std::cout << "product: " << ascii_scientific(product) << '\n';
 
         float fproduct = product;
         std::cout << "product: " << fproduct << '\n';
@@ -122,10 +122,10 @@ int main() {
     {
         binary32 foo{42.0f};
         binary32 bar{-10.0f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 product = foo * bar;
-        std::cout << "product: " << product.ascii_scientific() << '\n';
+        std::cout << "product: " << ascii_scientific(product) << '\n';
 
         float fproduct = product;
         std::cout << "product: " << fproduct << '\n';
@@ -133,10 +133,10 @@ int main() {
     {
         binary32 foo{-42.0f};
         binary32 bar{-10.0f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 product = foo * bar;
-        std::cout << "product: " << product.ascii_scientific() << '\n';
+        std::cout << "product: " << ascii_scientific(product) << '\n';
 
         float fproduct = product;
         std::cout << "product: " << fproduct << '\n';
@@ -145,10 +145,10 @@ int main() {
     {
         binary32 foo{3.99999976158142089844f};
         binary32 bar{3.99999976158142089844f};
-        std::cout << foo.ascii_scientific() << '\n';
-        std::cout << bar.ascii_scientific() << '\n';
+        std::cout << ascii_scientific(foo) << '\n';
+        std::cout << ascii_scientific(bar) << '\n';
         binary32 product = foo * bar;
-        std::cout << "product: " << product.ascii_scientific() << '\n';
+        std::cout << "product: " << ascii_scientific(product) << '\n';
 
         float fproduct = product;
         std::cout << "product: " << fproduct << '\n';
@@ -2,21 +2,409 @@
 #define MANTISSA_MAIN_H
 
 #include <bit>
-#include <bitset>
+#include <cstddef>
 #include <cstdint>
-#include <iostream>
-#include <string>
+#include <type_traits>
 #include <version>
 
 using u32 = uint32_t;
 using s32 = int32_t;
 using s8 = int8_t;
+using u8 = uint8_t;
+using u64 = uint64_t;
+using s64 = int64_t;
+
+/// Return the amount of zero bits above the most significant set bit;
+/// 64 when no bit is set at all.
+constexpr int count_leading_zeros(u64 x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return x ? __builtin_clzll(x) : 64;
+#else
+    int n = 0;
+    if (!x) return 64;
+    if (!(x & 0xffffffff00000000)) { n += 32; x <<= 32; }
+    if (!(x & 0xffff000000000000)) { n += 16; x <<= 16; }
+    if (!(x & 0xff00000000000000)) { n += 8; x <<= 8; }
+    if (!(x & 0xf000000000000000)) { n += 4; x <<= 4; }
+    if (!(x & 0xc000000000000000)) { n += 2; x <<= 2; }
+    if (!(x & 0x8000000000000000)) { n += 1; }
+    return n;
+#endif
+}
+
+/// Branch-free select: `if_true` when `condition` holds, otherwise
+/// `if_false`.
+constexpr u64 select_bits(bool condition, u64 if_true, u64 if_false) {
+    u64 mask = u64(0) - u64(condition);
+    return (if_true & mask) | (if_false & ~mask);
+}
+
+/// Full 64x64 -> 128 bit unsigned multiplication, split into the high
+/// and low halves of the product.
+constexpr void multiply_wide(u64 lhs, u64 rhs, u64& hi, u64& lo) {
+    u64 lhs_lo = lhs & 0xffffffff;
+    u64 lhs_hi = lhs >> 32;
+    u64 rhs_lo = rhs & 0xffffffff;
+    u64 rhs_hi = rhs >> 32;
+
+    u64 lolo = lhs_lo * rhs_lo;
+    u64 lohi = lhs_lo * rhs_hi;
+    u64 hilo = lhs_hi * rhs_lo;
+    u64 hihi = lhs_hi * rhs_hi;
+
+    u64 middle = (lolo >> 32) + (lohi & 0xffffffff) + (hilo & 0xffffffff);
+    lo = (middle << 32) | (lolo & 0xffffffff);
+    hi = hihi + (lohi >> 32) + (hilo >> 32) + (middle >> 32);
+}
+
+/// How a value that doesn't fit exactly within a format's mantissa
+/// ends up being represented in it.
+enum class RoundingMode {
+    /// Drop every bit that doesn't fit.
+    TowardZero,
+    /// Pick the closest representable value; exact ties go to the one
+    /// with an even mantissa. This is what IEEE-754 does by default.
+    NearestEven,
+    /// Round away from zero with a probability equal to the fraction of
+    /// an ULP that was cut off, so the rounding error is zero on
+    /// average. Needs 64 random bits per rounding.
+    Stochastic,
+};
+
+/// The splitmix64 finaliser; a cheap, well-mixed 64-bit hash.
+constexpr u64 splitmix64(u64 x) {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+/// Counter-based random number generator: there is no state to
+/// advance, the random bits for an index are a pure function of the
+/// seed and that index. Any thread can produce the bits for any element
+/// without coordinating with the others, the same seed always gives the
+/// same results no matter how work is split up, and loops over indices
+/// are free to be vectorised.
+struct CounterRNG {
+    u64 key{};
+
+    constexpr CounterRNG() {}
+    constexpr CounterRNG(u64 seed) : key(splitmix64(seed)) {}
+
+    constexpr u64 operator()(u64 index) const {
+        return splitmix64(key ^ index);
+    }
+};
+
+/// An unpacked floating point value with a 64-bit significand, used as
+/// the intermediate for rounding into (and converting between) every
+/// `FloatImpl` format.
+///
+/// A finite, non-zero value is `significand * 2^(exponent - 63)`, with
+/// the significand normalised so that bit 63 is set. `sticky` is set
+/// when non-zero bits below the significand were lost along the way.
+struct WideFloat {
+    enum Kind : u8 {
+        Zero,
+        Finite,
+        Infinity,
+        NotANumber,
+    };
+
+    Kind kind{Zero};
+    bool negative{false};
+    bool sticky{false};
+    s32 exponent{};
+    u64 significand{};
+
+    constexpr WideFloat negated() const {
+        WideFloat out = *this;
+        out.negative = !negative;
+        return out;
+    }
+};
+
+/// Sum of two wide values, rounded to a 64-bit significand plus sticky;
+/// plenty to round correctly into any format with less than 63 bits of
+/// precision.
+constexpr WideFloat wide_add(WideFloat lhs, WideFloat rhs) {
+    WideFloat out{};
+    if (lhs.kind == WideFloat::NotANumber) return lhs;
+    if (rhs.kind == WideFloat::NotANumber) return rhs;
+    if (lhs.kind == WideFloat::Infinity) {
+        /// infinity - infinity is NaN.
+        if (rhs.kind == WideFloat::Infinity && rhs.negative != lhs.negative) {
+            out.kind = WideFloat::NotANumber;
+            return out;
+        }
+        return lhs;
+    }
+    if (rhs.kind == WideFloat::Infinity) return rhs;
+    if (rhs.kind == WideFloat::Zero) {
+        /// -0 + -0 is -0, any other sum of zeroes is +0.
+        if (lhs.kind == WideFloat::Zero) lhs.negative = lhs.negative && rhs.negative;
+        return lhs;
+    }
+    if (lhs.kind == WideFloat::Zero) return rhs;
+
+    // Make LHS the operand with the larger magnitude.
+    if (lhs.exponent < rhs.exponent
+        || (lhs.exponent == rhs.exponent && lhs.significand < rhs.significand)) {
+        WideFloat tmp = lhs;
+        lhs = rhs;
+        rhs = tmp;
+    }
+
+    // Align the smaller operand within a 128-bit window (hi:lo) below
+    // the larger one; anything that falls out of the bottom of that
+    // only contributes to sticky.
+    bool right_sticky = rhs.sticky;
+    u64 right_hi = rhs.significand;
+    u64 right_lo = 0;
+    s64 difference = s64(lhs.exponent) - rhs.exponent;
+    if (difference >= 128) {
+        right_hi = 0;
+        right_sticky = true;
+    } else if (difference >= 64) {
+        right_hi = 0;
+        right_lo = rhs.significand >> (difference - 64);
+        if (difference > 64) right_sticky |= (rhs.significand << (128 - difference)) != 0;
+    } else if (difference) {
+        right_hi = rhs.significand >> difference;
+        right_lo = rhs.significand << (64 - difference);
+    }
+
+    bool sticky = lhs.sticky || right_sticky;
+    s32 new_exponent = lhs.exponent;
+    u64 hi{};
+    u64 lo{};
+    if (lhs.negative == rhs.negative) {
+        lo = right_lo;
+        hi = lhs.significand + right_hi;
+        // Carry out of the top; shift it back in.
+        if (hi < lhs.significand) {
+            sticky |= (lo & 1) != 0;
+            lo = (lo >> 1) | (hi << 63);
+            hi = (hi >> 1) | (u64(1) << 63);
+            ++new_exponent;
+        }
+    } else {
+        lo = u64(0) - right_lo;
+        hi = lhs.significand - right_hi - (right_lo != 0);
+        // The bits lost from the right hand side mean the true
+        // difference is a little less than what we've got.
+        if (right_sticky && lo-- == 0) --hi;
+        if (!hi && !lo) return out;
+        if (!hi) {
+            hi = lo;
+            lo = 0;
+            new_exponent -= 64;
+        }
+        int shift = count_leading_zeros(hi);
+        if (shift) {
+            hi = (hi << shift) | (lo >> (64 - shift));
+            lo <<= shift;
+            new_exponent -= shift;
+        }
+    }
+
+    out.kind = WideFloat::Finite;
+    out.negative = lhs.negative;
+    out.sticky = sticky || lo;
+    out.exponent = new_exponent;
+    out.significand = hi;
+    return out;
+}
+
+/// Product of two wide values, rounded to a 64-bit significand plus
+/// sticky.
+constexpr WideFloat wide_mul(WideFloat lhs, WideFloat rhs) {
+    WideFloat out{};
+    out.negative = lhs.negative != rhs.negative;
+    if (lhs.kind == WideFloat::NotANumber) return lhs;
+    if (rhs.kind == WideFloat::NotANumber) return rhs;
+    if (lhs.kind == WideFloat::Infinity || rhs.kind == WideFloat::Infinity) {
+        /// Infinity * zero is NaN.
+        if (lhs.kind == WideFloat::Zero || rhs.kind == WideFloat::Zero)
+            out.kind = WideFloat::NotANumber;
+        else out.kind = WideFloat::Infinity;
+        return out;
+    }
+    if (lhs.kind == WideFloat::Zero || rhs.kind == WideFloat::Zero) return out;
+
+    u64 hi{};
+    u64 lo{};
+    multiply_wide(lhs.significand, rhs.significand, hi, lo);
+    out.kind = WideFloat::Finite;
+    out.exponent = lhs.exponent + rhs.exponent + 1;
+    // Both significands are in [2^63, 2^64), so the product is in
+    // [2^126, 2^128) and needs at most one bit of normalisation.
+    if (!(hi >> 63)) {
+        hi = (hi << 1) | (lo >> 63);
+        lo <<= 1;
+        --out.exponent;
+    }
+    out.significand = hi;
+    out.sticky = lo || lhs.sticky || rhs.sticky;
+    return out;
+}
+
+/// `lhs * rhs + addend`, keeping the whole 128-bit product through the
+/// addition, so the only rounding is to the 64-bit significand (plus
+/// sticky) of the result.
+constexpr WideFloat wide_fused_multiply_add(WideFloat lhs, WideFloat rhs, WideFloat addend) {
+    // With a zero, infinite or NaN term, the product is exact (or doesn't
+    // matter) in the ordinary wide form.
+    if (lhs.kind != WideFloat::Finite || rhs.kind != WideFloat::Finite || addend.kind != WideFloat::Finite)
+        return wide_add(wide_mul(lhs, rhs), addend);
+
+    // Both terms are held in a 192-bit window (limb 0 is the most
+    // significant) with their leading one at the top.
+    u64 big[3]{};
+    multiply_wide(lhs.significand, rhs.significand, big[0], big[1]);
+    s32 big_exponent = lhs.exponent + rhs.exponent + 1;
+    if (!(big[0] >> 63)) {
+        big[0] = (big[0] << 1) | (big[1] >> 63);
+        big[1] <<= 1;
+        --big_exponent;
+    }
+    bool big_negative = lhs.negative != rhs.negative;
+    bool big_sticky = lhs.sticky || rhs.sticky;
+    u64 small[3]{addend.significand, 0, 0};
+    s32 small_exponent = addend.exponent;
+    bool small_negative = addend.negative;
+    bool small_sticky = addend.sticky;
+
+    // Make `big` the term with the larger magnitude.
+    bool swap = small_exponent > big_exponent;
+    if (small_exponent == big_exponent)
+        swap = small[0] > big[0] || (small[0] == big[0] && small[1] > big[1]);
+    if (swap) {
+        for (int i = 0; i < 3; ++i) {
+            u64 tmp = big[i];
+            big[i] = small[i];
+            small[i] = tmp;
+        }
+        s32 tmp_exponent = big_exponent;
+        big_exponent = small_exponent;
+        small_exponent = tmp_exponent;
+        bool tmp_negative = big_negative;
+        big_negative = small_negative;
+        small_negative = tmp_negative;
+        bool tmp_sticky = big_sticky;
+        big_sticky = small_sticky;
+        small_sticky = tmp_sticky;
+    }
+
+    // Align the smaller term. Bits only fall out of the window when it is
+    // far enough below the larger one that at most one bit cancels.
+    s64 difference = s64(big_exponent) - small_exponent;
+    if (difference >= 192) {
+        small[0] = small[1] = small[2] = 0;
+        small_sticky = true;
+    } else if (difference) {
+        int limbs = int(difference / 64);
+        int bits = int(difference % 64);
+        for (int i = 0; i < 3; ++i) {
+            if (i + limbs > 2) small_sticky |= small[i] != 0;
+            else if (i + limbs == 2 && bits) small_sticky |= (small[i] << (64 - bits)) != 0;
+        }
+        u64 shifted[3]{};
+        for (int i = limbs; i < 3; ++i) {
+            shifted[i] = small[i - limbs] >> bits;
+            if (bits && i - limbs > 0) shifted[i] |= small[i - limbs - 1] << (64 - bits);
+        }
+        for (int i = 0; i < 3; ++i) small[i] = shifted[i];
+    }
+
+    WideFloat out{};
+    s32 new_exponent = big_exponent;
+    bool sticky = big_sticky || small_sticky;
+    if (big_negative == small_negative) {
+        u64 carry = 0;
+        for (int i = 2; i >= 0; --i) {
+            u64 sum = big[i] + small[i];
+            u64 next_carry = sum < big[i];
+            sum += carry;
+            next_carry |= sum < carry;
+            big[i] = sum;
+            carry = next_carry;
+        }
+        // Carry out of the top; shift it back in.
+        if (carry) {
+            sticky |= (big[2] & 1) != 0;
+            big[2] = (big[2] >> 1) | (big[1] << 63);
+            big[1] = (big[1] >> 1) | (big[0] << 63);
+            big[0] = (big[0] >> 1) | (u64(1) << 63);
+            ++new_exponent;
+        }
+    } else {
+        u64 borrow = 0;
+        for (int i = 2; i >= 0; --i) {
+            u64 next_borrow = big[i] < small[i] || (big[i] - small[i]) < borrow;
+            big[i] = big[i] - small[i] - borrow;
+            borrow = next_borrow;
+        }
+        // The bits lost from the smaller term mean the true difference
+        // is a little less than what we've got.
+        if (small_sticky && (big[0] || big[1] || big[2]))
+            for (int i = 2; i >= 0 && big[i]-- == 0; --i) {}
+        while (!big[0]) {
+            if (!big[1] && !big[2]) return out;
+            big[0] = big[1];
+            big[1] = big[2];
+            big[2] = 0;
+            new_exponent -= 64;
+        }
+        int shift = count_leading_zeros(big[0]);
+        if (shift) {
+            big[0] = (big[0] << shift) | (big[1] >> (64 - shift));
+            big[1] = (big[1] << shift) | (big[2] >> (64 - shift));
+            big[2] <<= shift;
+            new_exponent -= shift;
+        }
+    }
+
+    out.kind = WideFloat::Finite;
+    out.negative = big_negative;
+    out.sticky = sticky || big[1] || big[2];
+    out.exponent = new_exponent;
+    out.significand = big[0];
+    return out;
+}
+
+/// Exact wide value of `value * 2^exponent`.
+constexpr WideFloat wide_from_integer(s64 value, s32 exponent = 0) {
+    WideFloat out{};
+    if (!value) return out;
+    out.kind = WideFloat::Finite;
+    out.negative = value < 0;
+    u64 magnitude = out.negative ? u64(0) - u64(value) : u64(value);
+    int shift = count_leading_zeros(magnitude);
+    out.exponent = exponent + 63 - shift;
+    out.significand = magnitude << shift;
+    return out;
+}
+
+/// Which bit patterns of a format mean infinity and NaN.
+enum class Encoding {
+    /// IEEE-754: an exponent with every bit set is infinity (with a zero
+    /// mantissa) or NaN (with any other mantissa).
+    IEEE,
+    /// No infinity; only every exponent *and* mantissa bit set is NaN,
+    /// so the top binade holds finite values too (OCP FP8 E4M3).
+    FiniteAndNaN,
+    /// No infinity or NaN at all; every bit pattern is a finite value
+    /// (OCP FP4 E2M1).
+    Finite,
+};
 
 template<
     typename Repr,
     Repr sign_bit,
     Repr exponent_bit,
-    Repr exponent_bias>
+    Repr exponent_bias,
+    Encoding encoding_ = Encoding::IEEE>
 struct FloatImpl {
     static constexpr size_t representation_bits = sizeof(Repr) * 8;
     static_assert(sign_bit < representation_bits, "Sign bit must fit within underlying representation.");
@@ -30,18 +418,44 @@ struct FloatImpl {
     static constexpr Repr mantissa_bit = 0;
     static constexpr Repr mantissa_mask = (Repr(1) << exponent_bit) - 1;
 
+    static constexpr Encoding encoding = encoding_;
+
+    /// Amount of significant bits, including the implicit leading one.
+    static constexpr s32 precision = 1 + exponent_bit;
+    /// Largest and smallest exponent a normal number may have.
+    static constexpr s32 exponent_max = s32(exponent_mask >> exponent_bit) - (encoding == Encoding::IEEE) - s32(exponent_bias);
+    static constexpr s32 exponent_min = 1 - s32(exponent_bias);
+
+    /// Magnitude bits of the largest finite value, and of the NaN that
+    /// invalid operations produce (the quiet one, for IEEE formats).
+    static constexpr Repr largest_finite = encoding == Encoding::IEEE
+        ? Repr((exponent_mask - (Repr(1) << exponent_bit)) | mantissa_mask)
+        : encoding == Encoding::FiniteAndNaN ? Repr(exponent_mask | (mantissa_mask - 1))
+        : Repr(exponent_mask | mantissa_mask);
+    static constexpr Repr not_a_number_bits = encoding == Encoding::IEEE
+        ? Repr(exponent_mask | (Repr(1) << (exponent_bit - 1)))
+        : Repr(exponent_mask | mantissa_mask);
+
     Repr representation{};
 
     constexpr FloatImpl() {}
     constexpr FloatImpl(Repr repr) : representation(repr) {}
+    /// Reinterpret the bits of a hardware float; only for 32-bit formats.
+    /// Other formats round through `from_float()` and `to_float()`.
 #if __has_cpp_attribute(__cpp_lib_bit_cast)
-    constexpr FloatImpl(float f) : representation(std::bit_cast<Repr>(f)) {}
+    constexpr FloatImpl(float f) : representation(std::bit_cast<Repr>(f)) {
+        static_assert(sizeof(Repr) == sizeof(float), "Only a 32-bit format can hold the bits of a float; use from_float().");
+    }
     constexpr float() {
+        static_assert(sizeof(Repr) == sizeof(float), "Only a 32-bit format can hold the bits of a float; use to_float().");
         return std::bit_cast<float>(representation);
     }
 #else
-    constexpr FloatImpl(float f) : representation(*reinterpret_cast<Repr*>(&f)) {}
+    constexpr FloatImpl(float f) : representation(*reinterpret_cast<Repr*>(&f)) {
+        static_assert(sizeof(Repr) == sizeof(float), "Only a 32-bit format can hold the bits of a float; use from_float().");
+    }
     constexpr operator float() {
+        static_assert(sizeof(Repr) == sizeof(float), "Only a 32-bit format can hold the bits of a float; use to_float().");
         return *reinterpret_cast<float*>(&representation);
     }
 #endif
@@ -55,7 +469,7 @@ struct FloatImpl {
 
     constexpr void set_negative(bool isNegative) {
         representation &= ~sign_mask;
-        if (isNegative) representation |= 1 << sign_bit;
+        if (isNegative) representation |= Repr(1) << sign_bit;
     }
 
     constexpr SignedRepr exponent() const {
@@ -82,7 +496,7 @@ struct FloatImpl {
     }
 
     constexpr Repr mantissa() const {
-        return mantissa_no_leading() | (1 << exponent_bit);
+        return mantissa_no_leading() | (Repr(1) << exponent_bit);
     }
 
     constexpr void set_mantissa(Repr mantissa) {
@@ -109,7 +523,7 @@ struct FloatImpl {
         // Make mantissa a non-zero value to indicate NaN vs infinity.
         representation |= mantissa_mask;
         // Clear top bit of mantissa as this is not a signalling NaN.
-        representation &= ~(1 << (exponent_bit - 1));
+        representation &= ~(Repr(1) << (exponent_bit - 1));
         set_negative(isNegative);
     }
 
@@ -147,53 +561,63 @@ struct FloatImpl {
         return exponent_zeroes() && !mantissa();
     }
 
-    std::string mantissa_string(Repr base = 10) const {
-        Repr mtsa = mantissa_no_leading();
-        std::string out;
-        if (mtsa) {
-            while (mtsa) {
-                mtsa *= base;
-                out += '0' + ((mtsa & ~mantissa_mask) >> exponent_bit);
-                mtsa &= mantissa_mask;
-            }
-            return out;
-        }
-        return "0";
+    /// Return true iff this is neither infinity nor NaN.
+    constexpr bool is_finite() const {
+        if constexpr (encoding == Encoding::IEEE) return !exponent_ones();
+        else if constexpr (encoding == Encoding::FiniteAndNaN) return (representation & ~sign_mask) != not_a_number_bits;
+        else return true;
     }
 
-    std::string ascii_scientific() const {
-        std::string out;
-        if (negative()) out += '-';
-        if (exponent_zeroes()) {
-            // Zero
-            if (!mantissa()) {
-                out += '0';
-                return out;
-            }
-            // Subnormal
-            out += "0.";
-            out += mantissa_string();
-            out += "x2^-126";
+    /// Unpack into a wide intermediate that holds this value exactly.
+    constexpr WideFloat widen() const {
+        static_assert(exponent_bit < 62, "Mantissa must fit within a wide intermediate with room left to round.");
+        WideFloat out{};
+        out.negative = negative();
+        if (!is_finite()) {
+            out.kind = mantissa_no_leading() ? WideFloat::NotANumber : WideFloat::Infinity;
             return out;
         }
-        // Every bit set in the exponent means infinity or NaN.
-        else if (exponent_ones()) {
-            // Infinity
-            if (!mantissa()) {
-                out += "inf";
-                return out;
-            }
-            // Not a Number (NaN)
-            out += "NaN";
+        if (exponent_zeroes()) {
+            if (!mantissa_no_leading()) return out;
+            // Subnormal: there is no implicit leading one, and the
+            // exponent is the smallest a normal number may have.
+            int shift = count_leading_zeros(mantissa_no_leading());
+            out.kind = WideFloat::Finite;
+            out.exponent = 63 - shift + 1 - s32(exponent_bias) - s32(exponent_bit);
+            out.significand = u64(mantissa_no_leading()) << shift;
             return out;
         }
-        out += "1.";
-        out += mantissa_string();
-        out += "x2^";
-        out += std::to_string(exponent());
+        out.kind = WideFloat::Finite;
+        out.exponent = exponent();
+        out.significand = u64(mantissa()) << (63 - exponent_bit);
         return out;
     }
 
+    /// Round a wide intermediate into this format. `random_bits` is
+    /// only used by `RoundingMode::Stochastic`, and should be uniformly
+    /// distributed (i.e. from a `CounterRNG`).
+    ///
+    /// Formats without infinity saturate to their largest finite value
+    /// instead of overflowing, and formats without NaN saturate NaN too,
+    /// as there is nothing closer to return.
+    static constexpr FloatImpl round_from(WideFloat value, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0);
+
+    /// Convert to another `FloatImpl` format, rounding as requested.
+    template<typename To>
+    constexpr To convert(RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) const {
+        return To::round_from(widen(), mode, random_bits);
+    }
+
+    /// Round a hardware float into this format.
+    static constexpr FloatImpl from_float(float f, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+        return FloatImpl<u32, 31, 23, 127>{f}.template convert<FloatImpl>(mode, random_bits);
+    }
+
+    /// Round into a hardware float.
+    constexpr float to_float(RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) const {
+        return float(convert<FloatImpl<u32, 31, 23, 127>>(mode, random_bits));
+    }
+
     constexpr void add(FloatImpl rhs) {
         /// X + 0 is still X.
         if (rhs.is_zero()) return;
@@ -324,133 +748,428 @@ struct FloatImpl {
         return lhs;
     }
 
-    void mul(FloatImpl rhs) {
-        /// Zero * anything is still zero.
-        /// NaN * anything is still NaN.
-        /// Infinity * anything is still infinity.
-        if (is_zero() || is_not_a_number() || is_infinity()) return;
-        /// Anything * zero is still zero.
-        /// Anything * NaN is still NaN.
-        /// Anything * infinity is still infinity.
-        if (rhs.is_zero() || rhs.is_not_a_number() || rhs.is_infinity()) {
-            *this = rhs;
-            return;
-        }
-
-        // LaTeX:
-        // s_A.m_A.2^{{e}_A} \times s_A.m_A.2^{{e}_A} = (s_A \oplus s_B).m_A \times m_B.2^{(e_A + e_B) + n_{bias}}
-
-        Repr left_mantissa = mantissa();
-        Repr right_mantissa = rhs.mantissa();
-
-        // The sign of the product is equal to the exclusive logical disjunction of both operand's signs.
-        set_negative(negative() ^ rhs.negative());
-
-        // The exponent of the product is equal to the sum of both operand's exponents.
-        set_exponent(exponent() + rhs.exponent());
-
-        // The mantissa of the product is equal to the multiplication of both operand's mantissas.
-
-        // When multiplying, the product requires twice as much storage as the
-        // operands; for a 24-bit mantissa, this would require 48 bits for the
-        // product. Because things can get kind of weird here with bit numbers,
-        // we just use two of the underlying representation for each half of
-        // the bits. This is a software version of a very dumbed-down
-        // Karatsuba-Urdhva multiplier, afaik.
-
-        // NOTE:
-        // 4.20f * 10.0f == 42.0f but it actually equals 41.9922 with the following code...
-        // 4.20f == 0b01000000100001100110011001100110
-        //            = not signed
-        //             ======== exponent of +2
-        //                     ======================= mantissa of 00_0011_ repeating
-        // 10.0f == 0b01000001001000000000000000000000
-        //            = not signed
-        //             ======== exponent of +3
-        //                     ======================= mantissa of 01
-        // 42.0f == 0b01000010001010000000000000000000
-        //            = not signed
-        //             ======== exponent of +5
-        //                     ======================= mantissa of 0101
-        // I am quite confusion.
-        // 4.20f mantissa is 0b1.00001100110011001100110
-        // 10.0f mantissa is 0b1.01000000000000000000000
-        // When you multiply these binary numbers (including the implicit
-        // leading one), you get 1.01001111111 (in binary still). How are we
-        // meant to convert that into 1.01010000000? If there are a certain
-        // amount of 1s in a row do we just turn them higher? I *must* be
-        // missing something...
-
-        // exponent_bit stores the first index after the mantissa, which can
-        // also be thought of as the amount of mantissa bits stored in the
-        // representation. The leading, hidden one + this number is equal to
-        // the bit precision of this float format.
-        static constexpr Repr bits_precision = (1 + exponent_bit);
-        // Amount of mantissa bits over two (half)
-        static constexpr Repr shift_amount_lo = bits_precision / 2 + (bits_precision % 2);
-        static constexpr Repr shift_mask_lo = (Repr(1) << shift_amount_lo) - 1;
-        static constexpr Repr shift_amount_hi = bits_precision / 2;
-        static constexpr Repr shift_mask_hi = ((Repr(1) << shift_amount_hi) - 1) << shift_amount_lo;
-
-        Repr left_lo = left_mantissa & shift_mask_lo;
-        Repr right_lo = right_mantissa & shift_mask_lo;
-        Repr left_hi = left_mantissa >> shift_amount_lo;
-        Repr right_hi = right_mantissa >> shift_amount_lo;
-
-        Repr low_mantissa = left_lo * right_lo;
-        Repr lowhigh_mantissa = left_lo * right_hi;
-        Repr highlow_mantissa = left_hi * right_lo;
-        Repr high_mantissa = left_hi * right_hi;
-
-
-        /*
-        std::bitset<shift_amount_lo> left_lo_bits = {left_lo};
-        std::bitset<shift_amount_lo> right_lo_bits = {right_lo};
-        std::bitset<shift_amount_hi> left_hi_bits = {left_hi};
-        std::bitset<shift_amount_hi> right_hi_bits = {right_hi};
-        std::cout << "lo * lo:\n"
-                  << "              " << left_lo_bits << '\n'
-                  << " *            " << right_lo_bits << '\n'
-                  << " =" << std::bitset<exponent_bit + 1>(low_mantissa) << '\n';
-        std::cout << "lo * hi:\n"
-                  << "              " << left_lo_bits << '\n'
-                  << " *            " << right_hi_bits << '\n'
-                  << " =" << std::bitset<exponent_bit + 1>(lowhigh_mantissa) << '\n';
-        std::cout << "hi * lo:\n"
-                  << "              " << left_hi_bits << '\n'
-                  << " *            " << right_lo_bits << '\n'
-                  << " =" << std::bitset<exponent_bit + 1>(highlow_mantissa) << '\n';
-        std::cout << "hi * hi:\n"
-                  << "              " << left_hi_bits << '\n'
-                  << " *            " << right_hi_bits << '\n'
-                  << " =" << std::bitset<exponent_bit + 1>(high_mantissa) << '\n';
-        */
-
-        //   11
-        // * 18
-        // -----
-        //   88  (8*1)x10^0 + (8*1)x10^1
-        //  110  (1*1)*10^1 + (1*1)x10^2
-        //
-        Repr firstrow = low_mantissa + (lowhigh_mantissa << (shift_amount_lo + 1));
-        Repr secondrow = high_mantissa + (highlow_mantissa >> (shift_amount_lo));
-        Repr new_mantissa = (firstrow << shift_amount_lo) + (secondrow);
-        new_mantissa += 1;
-        new_mantissa &= ~1;
-        new_mantissa <<= 1;
-
-        //std::cout << "new mantissa: \n" << std::bitset<sizeof(Repr) * 8>(new_mantissa) << '\n';
-
-        set_mantissa_normalised(new_mantissa);
-    }
+    void mul(FloatImpl rhs);
 
     constexpr FloatImpl operator*(FloatImpl rhs) const {
         rhs.mul(*this);
         return rhs;
     }
+
+    /// Rounded arithmetic: the exact result is computed in a wide
+    /// intermediate and then rounded once, using the given mode.
+    constexpr void add(FloatImpl rhs, RoundingMode mode, u64 random_bits = 0) {
+        *this = round_from(wide_add(widen(), rhs.widen()), mode, random_bits);
+    }
+
+    constexpr void sub(FloatImpl rhs, RoundingMode mode, u64 random_bits = 0) {
+        *this = round_from(wide_add(widen(), rhs.widen().negated()), mode, random_bits);
+    }
+
+    constexpr void mul(FloatImpl rhs, RoundingMode mode, u64 random_bits = 0) {
+        *this = round_from(wide_mul(widen(), rhs.widen()), mode, random_bits);
+    }
+
+    /// this = lhs * rhs + this, with a single rounding; the product is
+    /// kept exactly through the addition.
+    constexpr void fused_multiply_add(FloatImpl lhs, FloatImpl rhs, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+        // Up to 32 bits of precision, the product fits a wide significand
+        // exactly, and the cheaper ordinary wide addition is enough.
+        if constexpr (precision <= 32)
+            *this = round_from(wide_add(wide_mul(lhs.widen(), rhs.widen()), widen()), mode, random_bits);
+        else *this = round_from(wide_fused_multiply_add(lhs.widen(), rhs.widen(), widen()), mode, random_bits);
+    }
+
+    /// Constant-time arithmetic, rounded to nearest, ties to even.
+    ///
+    /// Same results as the rounded `add`/`sub`/`mul` (NaN payloads
+    /// aside), but with no data-dependent branches or loops: special
+    /// cases are computed with masks and selected at the end, alignment
+    /// is a single clamped shift, and normalisation counts leading zeros.
+    /// Latency doesn't depend on the operands.
+    constexpr void add_constant_time(FloatImpl rhs);
+    constexpr void sub_constant_time(FloatImpl rhs);
+    constexpr void mul_constant_time(FloatImpl rhs);
+
+    /// Branch-free rounding of `significand * 2^(exponent - 63)` into
+    /// this format. Bits below the significand must already be folded
+    /// into its lowest bit; a zero significand gives a signed zero.
+    static constexpr Repr pack_constant_time(bool isNegative, s64 exponent, u64 significand);
 };
 
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding_>
+constexpr FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>
+FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>::round_from(WideFloat value, RoundingMode mode, u64 random_bits) {
+    FloatImpl out{};
+    switch (value.kind) {
+    case WideFloat::Zero:
+        out.set_zero(value.negative);
+        return out;
+    case WideFloat::NotANumber:
+        out.representation = encoding == Encoding::Finite ? largest_finite : not_a_number_bits;
+        out.set_negative(value.negative);
+        return out;
+    case WideFloat::Infinity:
+        out.representation = encoding == Encoding::IEEE ? exponent_mask : largest_finite;
+        out.set_negative(value.negative);
+        return out;
+    case WideFloat::Finite: break;
+    }
+
+    s64 biased_exponent = s64(value.exponent) + exponent_bias;
+    if (value.exponent > exponent_max) {
+        // Too large to represent; truncation stops at the largest
+        // finite value, everything else overflows to infinity (if there
+        // is one).
+        if (mode == RoundingMode::TowardZero || encoding != Encoding::IEEE)
+            out.representation = largest_finite;
+        else out.representation = exponent_mask;
+        out.set_negative(value.negative);
+        return out;
+    }
+
+    // Amount of low significand bits that don't fit in the mantissa.
+    // Subnormals lose one more bit for every step the exponent is
+    // below the smallest normal one.
+    s64 shift = 64 - precision;
+    if (biased_exponent < 1) {
+        shift += 1 - biased_exponent;
+        biased_exponent = 0;
+    }
+
+    // `fraction` is the part of an ULP that was cut off, as a
+    // 0.64 fixed point number.
+    u64 kept{};
+    u64 fraction{};
+    bool sticky = value.sticky;
+    if (shift >= 128) sticky = true;
+    else if (shift >= 64) {
+        fraction = value.significand >> (shift - 64);
+        if (shift > 64) sticky |= (value.significand << (128 - shift)) != 0;
+    } else {
+        kept = value.significand >> shift;
+        fraction = value.significand << (64 - shift);
+    }
+
+    constexpr u64 half = u64(1) << 63;
+    bool round_up = false;
+    switch (mode) {
+    case RoundingMode::TowardZero: break;
+    case RoundingMode::NearestEven:
+        round_up = fraction > half || (fraction == half && (sticky || (kept & 1)));
+        break;
+    case RoundingMode::Stochastic:
+        round_up = random_bits < fraction;
+        break;
+    }
+
+    // For normal numbers, the implicit leading one in `kept` adds
+    // one to the exponent field, hence the minus one. A carry out of
+    // the mantissa when rounding up increments the exponent, and may
+    // land on infinity, which is exactly what we want. Without infinity,
+    // that saturates instead.
+    Repr packed = Repr(kept);
+    if (biased_exponent) packed += Repr(biased_exponent - 1) << exponent_bit;
+    packed += round_up;
+    if (encoding != Encoding::IEEE && packed > largest_finite) packed = largest_finite;
+    out.representation = packed;
+    out.set_negative(value.negative);
+    return out;
+}
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding_>
+void FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>::mul(FloatImpl rhs) {
+    /// Zero * anything is still zero.
+    /// NaN * anything is still NaN.
+    /// Infinity * anything is still infinity.
+    if (is_zero() || is_not_a_number() || is_infinity()) return;
+    /// Anything * zero is still zero.
+    /// Anything * NaN is still NaN.
+    /// Anything * infinity is still infinity.
+    if (rhs.is_zero() || rhs.is_not_a_number() || rhs.is_infinity()) {
+        *this = rhs;
+        return;
+    }
+
+    // LaTeX:
+    // s_A.m_A.2^{{e}_A} \times s_A.m_A.2^{{e}_A} = (s_A \oplus s_B).m_A \times m_B.2^{(e_A + e_B) + n_{bias}}
+
+    Repr left_mantissa = mantissa();
+    Repr right_mantissa = rhs.mantissa();
+
+    // The sign of the product is equal to the exclusive logical disjunction of both operand's signs.
+    set_negative(negative() ^ rhs.negative());
+
+    // The exponent of the product is equal to the sum of both operand's exponents.
+    set_exponent(exponent() + rhs.exponent());
+
+    // The mantissa of the product is equal to the multiplication of both operand's mantissas.
+
+    // When multiplying, the product requires twice as much storage as the
+    // operands; for a 24-bit mantissa, this would require 48 bits for the
+    // product. Because things can get kind of weird here with bit numbers,
+    // we just use two of the underlying representation for each half of
+    // the bits. This is a software version of a very dumbed-down
+    // Karatsuba-Urdhva multiplier, afaik.
+
+    // NOTE:
+    // 4.20f * 10.0f == 42.0f but it actually equals 41.9922 with the following code...
+    // 4.20f == 0b01000000100001100110011001100110
+    //            = not signed
+    //             ======== exponent of +2
+    //                     ======================= mantissa of 00_0011_ repeating
+    // 10.0f == 0b01000001001000000000000000000000
+    //            = not signed
+    //             ======== exponent of +3
+    //                     ======================= mantissa of 01
+    // 42.0f == 0b01000010001010000000000000000000
+    //            = not signed
+    //             ======== exponent of +5
+    //                     ======================= mantissa of 0101
+    // I am quite confusion.
+    // 4.20f mantissa is 0b1.00001100110011001100110
+    // 10.0f mantissa is 0b1.01000000000000000000000
+    // When you multiply these binary numbers (including the implicit
+    // leading one), you get 1.01001111111 (in binary still). How are we
+    // meant to convert that into 1.01010000000? If there are a certain
+    // amount of 1s in a row do we just turn them higher? I *must* be
+    // missing something...
+
+    // exponent_bit stores the first index after the mantissa, which can
+    // also be thought of as the amount of mantissa bits stored in the
+    // representation. The leading, hidden one + this number is equal to
+    // the bit precision of this float format.
+    static constexpr Repr bits_precision = (1 + exponent_bit);
+    // Amount of mantissa bits over two (half)
+    static constexpr Repr shift_amount_lo = bits_precision / 2 + (bits_precision % 2);
+    static constexpr Repr shift_mask_lo = (Repr(1) << shift_amount_lo) - 1;
+    static constexpr Repr shift_amount_hi = bits_precision / 2;
+    static constexpr Repr shift_mask_hi = ((Repr(1) << shift_amount_hi) - 1) << shift_amount_lo;
+
+    Repr left_lo = left_mantissa & shift_mask_lo;
+    Repr right_lo = right_mantissa & shift_mask_lo;
+    Repr left_hi = left_mantissa >> shift_amount_lo;
+    Repr right_hi = right_mantissa >> shift_amount_lo;
+
+    Repr low_mantissa = left_lo * right_lo;
+    Repr lowhigh_mantissa = left_lo * right_hi;
+    Repr highlow_mantissa = left_hi * right_lo;
+    Repr high_mantissa = left_hi * right_hi;
+
+
+    /*
+    std::bitset<shift_amount_lo> left_lo_bits = {left_lo};
+    std::bitset<shift_amount_lo> right_lo_bits = {right_lo};
+    std::bitset<shift_amount_hi> left_hi_bits = {left_hi};
+    std::bitset<shift_amount_hi> right_hi_bits = {right_hi};
+    std::cout << "lo * lo:\n"
+              << "              " << left_lo_bits << '\n'
+              << " *            " << right_lo_bits << '\n'
+              << " =" << std::bitset<exponent_bit + 1>(low_mantissa) << '\n';
+    std::cout << "lo * hi:\n"
+              << "              " << left_lo_bits << '\n'
+              << " *            " << right_hi_bits << '\n'
+              << " =" << std::bitset<exponent_bit + 1>(lowhigh_mantissa) << '\n';
+    std::cout << "hi * lo:\n"
+              << "              " << left_hi_bits << '\n'
+              << " *            " << right_lo_bits << '\n'
+              << " =" << std::bitset<exponent_bit + 1>(highlow_mantissa) << '\n';
+    std::cout << "hi * hi:\n"
+              << "              " << left_hi_bits << '\n'
+              << " *            " << right_hi_bits << '\n'
+              << " =" << std::bitset<exponent_bit + 1>(high_mantissa) << '\n';
+    */
+
+    //   11
+    // * 18
+    // -----
+    //   88  (8*1)x10^0 + (8*1)x10^1
+    //  110  (1*1)*10^1 + (1*1)x10^2
+    //
+    Repr firstrow = low_mantissa + (lowhigh_mantissa << (shift_amount_lo + 1));
+    Repr secondrow = high_mantissa + (highlow_mantissa >> (shift_amount_lo));
+    Repr new_mantissa = (firstrow << shift_amount_lo) + (secondrow);
+    new_mantissa += 1;
+    new_mantissa &= ~1;
+    new_mantissa <<= 1;
+
+    //std::cout << "new mantissa: \n" << std::bitset<sizeof(Repr) * 8>(new_mantissa) << '\n';
+
+    set_mantissa_normalised(new_mantissa);
+}
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding_>
+constexpr Repr FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>::pack_constant_time(bool isNegative, s64 exponent, u64 significand) {
+    static_assert(precision <= 61, "Constant-time kernels need at least two guard bits.");
+    static_assert(encoding == Encoding::IEEE, "Constant-time kernels only handle IEEE-754 infinity and NaN.");
+    constexpr s64 exponent_field_ones = exponent_mask >> exponent_bit;
+
+    s64 biased_exponent = exponent + exponent_bias;
+    bool subnormal = biased_exponent < 1;
+    // One bit is shifted out up front (and jammed into the lowest bit)
+    // so the remaining shift fits in 63 even for the tiniest results.
+    s64 shift = (64 - precision - 1) + s64(select_bits(subnormal, u64(1 - biased_exponent), 0));
+    bool too_tiny = shift > 63;
+    u64 jammed = (significand >> 1) | (significand & 1);
+    jammed = select_bits(too_tiny, jammed != 0, jammed);
+    shift = s64(select_bits(too_tiny, 63, u64(shift)));
+
+    u64 kept = jammed >> shift;
+    u64 remainder = jammed & ((u64(1) << shift) - 1);
+    u64 half = u64(1) << (shift - 1);
+    bool round_up = (remainder > half) | ((remainder == half) & ((kept & 1) != 0));
+
+    // The implicit leading one in `kept` adds one to the exponent field
+    // of normal numbers; a carry out of the mantissa does the same.
+    u64 exponent_field = select_bits(subnormal, 0, u64(biased_exponent - 1));
+    u64 packed = (exponent_field << exponent_bit) + kept + round_up;
+    packed = select_bits(biased_exponent >= exponent_field_ones, exponent_mask, packed);
+    packed = select_bits(significand == 0, 0, packed);
+    return Repr(packed | (u64(isNegative) << sign_bit));
+}
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding_>
+constexpr void FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>::add_constant_time(FloatImpl rhs) {
+    constexpr Repr magnitude_mask = exponent_mask | mantissa_mask;
+    constexpr Repr quiet_not_a_number = exponent_mask | (Repr(1) << (exponent_bit - 1));
+
+    // Make LHS the operand with the larger magnitude. For IEEE layouts,
+    // comparing magnitudes is an integer comparison.
+    Repr lhs_bits = representation;
+    Repr rhs_bits = rhs.representation;
+    bool swap = Repr(rhs_bits & magnitude_mask) > Repr(lhs_bits & magnitude_mask);
+    Repr big = Repr(select_bits(swap, rhs_bits, lhs_bits));
+    Repr small = Repr(select_bits(swap, lhs_bits, rhs_bits));
+
+    bool big_negative = big & sign_mask;
+    bool small_negative = small & sign_mask;
+    u64 big_field = (big & exponent_mask) >> exponent_bit;
+    u64 small_field = (small & exponent_mask) >> exponent_bit;
+    u64 big_mantissa = big & mantissa_mask;
+    u64 small_mantissa = small & mantissa_mask;
+
+    constexpr u64 field_ones = exponent_mask >> exponent_bit;
+    bool big_special = big_field == field_ones;
+    bool small_special = small_field == field_ones;
+    bool not_a_number = (big_special & (big_mantissa != 0))
+        | (small_special & (small_mantissa != 0))
+        | (big_special & small_special & (big_negative != small_negative));
+
+    // Significands with the implicit one (when normal), placed so the
+    // leading bit of the larger operand sits at bit 62: one bit of
+    // headroom for the carry, the rest are guard bits.
+    u64 big_significand = (big_mantissa | (u64(big_field != 0) << exponent_bit)) << (62 - exponent_bit);
+    u64 small_significand = (small_mantissa | (u64(small_field != 0) << exponent_bit)) << (62 - exponent_bit);
+    // Subnormals share the exponent of the smallest normal numbers.
+    s64 big_exponent = s64(big_field | (big_field == 0));
+    s64 small_exponent = s64(small_field | (small_field == 0));
+
+    u64 difference = u64(big_exponent - small_exponent);
+    u64 shift = select_bits(difference > 63, 63, difference);
+    u64 lost = small_significand & ((u64(1) << shift) - 1);
+    small_significand = (small_significand >> shift) | (lost != 0);
+
+    bool subtract = big_negative != small_negative;
+    u64 sum = select_bits(subtract, big_significand - small_significand, big_significand + small_significand);
+
+    int leading_zeros = count_leading_zeros(sum | 1);
+    u64 significand = sum << leading_zeros;
+    s64 exponent = big_exponent - s64(exponent_bias) + 1 - leading_zeros;
+    // An exact zero is positive, unless both operands were negative.
+    bool result_negative = select_bits(sum != 0, big_negative, big_negative & small_negative);
+    Repr packed = pack_constant_time(result_negative, exponent, significand);
+
+    Repr infinity = Repr(exponent_mask | (u64(big_negative) << sign_bit));
+    packed = Repr(select_bits(big_special, infinity, packed));
+    representation = Repr(select_bits(not_a_number, quiet_not_a_number, packed));
+}
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding_>
+constexpr void FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>::sub_constant_time(FloatImpl rhs) {
+    rhs.representation ^= sign_mask;
+    add_constant_time(rhs);
+}
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding_>
+constexpr void FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding_>::mul_constant_time(FloatImpl rhs) {
+    constexpr Repr quiet_not_a_number = exponent_mask | (Repr(1) << (exponent_bit - 1));
+    constexpr u64 field_ones = exponent_mask >> exponent_bit;
+
+    bool isNegative = negative() != rhs.negative();
+    u64 lhs_field = (representation & exponent_mask) >> exponent_bit;
+    u64 rhs_field = (rhs.representation & exponent_mask) >> exponent_bit;
+    u64 lhs_mantissa = representation & mantissa_mask;
+    u64 rhs_mantissa = rhs.representation & mantissa_mask;
+
+    bool lhs_special = lhs_field == field_ones;
+    bool rhs_special = rhs_field == field_ones;
+    bool lhs_zero = (lhs_field | lhs_mantissa) == 0;
+    bool rhs_zero = (rhs_field | rhs_mantissa) == 0;
+    bool infinity = (lhs_special & (lhs_mantissa == 0)) | (rhs_special & (rhs_mantissa == 0));
+    bool not_a_number = (lhs_special & (lhs_mantissa != 0))
+        | (rhs_special & (rhs_mantissa != 0))
+        | (infinity & (lhs_zero | rhs_zero));
+
+    // Normalise both significands to bit 63, so subnormals need no
+    // special treatment.
+    u64 lhs_significand = lhs_mantissa | (u64(lhs_field != 0) << exponent_bit);
+    u64 rhs_significand = rhs_mantissa | (u64(rhs_field != 0) << exponent_bit);
+    int lhs_leading_zeros = count_leading_zeros(lhs_significand | 1);
+    int rhs_leading_zeros = count_leading_zeros(rhs_significand | 1);
+    lhs_significand <<= lhs_leading_zeros;
+    rhs_significand <<= rhs_leading_zeros;
+    s64 lhs_exponent = s64(lhs_field | (lhs_field == 0)) - s64(exponent_bias) - s64(exponent_bit) + 63 - lhs_leading_zeros;
+    s64 rhs_exponent = s64(rhs_field | (rhs_field == 0)) - s64(exponent_bias) - s64(exponent_bit) + 63 - rhs_leading_zeros;
+
+    u64 hi{};
+    u64 lo{};
+    multiply_wide(lhs_significand, rhs_significand, hi, lo);
+    u64 top = hi >> 63;
+    u64 significand = select_bits(top, hi, (hi << 1) | (lo >> 63));
+    lo = select_bits(top, lo, lo << 1);
+    significand |= lo != 0;
+    s64 exponent = lhs_exponent + rhs_exponent + s64(top);
+    // A zero operand leaves a product with no leading one; make it zero.
+    significand = select_bits(lhs_zero | rhs_zero, 0, significand);
+    Repr packed = pack_constant_time(isNegative, exponent, significand);
+
+    Repr infinity_bits = Repr(exponent_mask | (u64(isNegative) << sign_bit));
+    packed = Repr(select_bits(infinity, infinity_bits, packed));
+    representation = Repr(select_bits(not_a_number, quiet_not_a_number, packed));
+}
+
 using binary32 = FloatImpl<u32, 31, 23, 127>;
+using binary64 = FloatImpl<u64, 63, 52, 1023>;
+using binary16 = FloatImpl<uint16_t, 15, 10, 15>;
+using bfloat16 = FloatImpl<uint16_t, 15, 7, 127>;
+/// 8-bit floats with the same layouts as the OCP FP8 formats. These
+/// follow IEEE-754 rules for infinity and NaN, so E4M3 has a smaller
+/// range than the OCP one (which uses the all ones exponent for finite
+/// values).
+using float8_e5m2 = FloatImpl<u8, 7, 2, 15>;
+using float8_e4m3 = FloatImpl<u8, 7, 3, 7>;
+/// 4-bit float with the layout of the OCP E2M1 format (also IEEE-754
+/// rules, so the largest finite value is 3, not 6). Stored one per byte.
+using float4_e2m1 = FloatImpl<u8, 3, 1, 1>;
+/// The OCP formats themselves: E4M3 without infinity and a single NaN
+/// (largest finite value 448), and E2M1 with neither (largest 6).
+using float8_e4m3fn = FloatImpl<u8, 7, 3, 7, Encoding::FiniteAndNaN>;
+using float4_e2m1fn = FloatImpl<u8, 3, 1, 1, Encoding::Finite>;
+
+/// Convert `count` values from one format to another. With
+/// `RoundingMode::Stochastic`, element `i` is rounded using the random
+/// bits `rng(first_index + i)`, so results don't depend on how a large
+/// conversion is split into chunks (or across threads), as long as each
+/// chunk passes its own offset as `first_index`.
+template<typename To, typename From>
+void convert(const From* in, To* out, size_t count, RoundingMode mode = RoundingMode::NearestEven, CounterRNG rng = {}, u64 first_index = 0) {
+    if (mode == RoundingMode::Stochastic) {
+        for (size_t i = 0; i < count; ++i)
+            out[i] = in[i].template convert<To>(RoundingMode::Stochastic, rng(first_index + i));
+        return;
+    }
+    for (size_t i = 0; i < count; ++i)
+        out[i] = in[i].template convert<To>(mode);
+}
 
 /// Call this macro with the test condition you'd like to ensure from a
 /// test's `main`.
@@ -0,0 +1,202 @@
+#ifndef MANTISSA_BLOCK_H
+#define MANTISSA_BLOCK_H
+
+#include <cstddef>
+#include <mantissa.h>
+
+/// Block floating point, in the style of the OCP microscaling (MX)
+/// formats: `block_size` elements of some small `FloatImpl` format that
+/// all share one power of two scale. The value of element `i` is
+/// `2^(scale - scale_bias) * elements[i]`.
+///
+/// The scale is stored like an MX E8M0 scale: an unsigned byte biased
+/// by 127, where all bits set means every element in the block is NaN.
+template<typename Element, size_t block_size = 32>
+struct BlockFloat {
+    static_assert(block_size, "A block must hold at least one element.");
+
+    static constexpr u8 scale_bias = 127;
+    static constexpr u8 scale_not_a_number = 0xff;
+    static constexpr s32 scale_exponent_min = -127;
+    static constexpr s32 scale_exponent_max = 127;
+
+    /// Every finite element is an integer multiple of the smallest
+    /// subnormal of `Element`, and fits in this many bits (plus sign).
+    static constexpr s32 fixed_point_exponent = Element::exponent_min - (Element::precision - 1);
+    static constexpr s32 fixed_point_bits = Element::exponent_max - fixed_point_exponent + 1;
+    /// When true, a whole block's dot product can be accumulated exactly
+    /// in a 64-bit integer.
+    static constexpr bool integer_dot = 2 * fixed_point_bits + (64 - count_leading_zeros(block_size - 1)) <= 62;
+
+    u8 scale{scale_bias};
+    Element elements[block_size]{};
+
+    constexpr bool is_not_a_number() const {
+        return scale == scale_not_a_number;
+    }
+
+    constexpr s32 scale_exponent() const {
+        return s32(scale) - scale_bias;
+    }
+
+    /// Element `i`, with the shared scale applied, as an exact wide value.
+    constexpr WideFloat widen(size_t i) const {
+        WideFloat out = elements[i].widen();
+        if (is_not_a_number()) out.kind = WideFloat::NotANumber;
+        else if (out.kind == WideFloat::Finite) out.exponent += scale_exponent();
+        return out;
+    }
+
+    /// Element `i`, with the shared scale applied, rounded into `To`.
+    template<typename To = binary32>
+    constexpr To get(size_t i, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) const {
+        return To::round_from(widen(i), mode, random_bits);
+    }
+
+    /// Element as an integer amount of `2^fixed_point_exponent`,
+    /// ignoring the shared scale. Only meaningful for finite elements.
+    static constexpr s64 fixed_point(Element element) {
+        constexpr s64 hidden = s64(Element::mantissa_mask) + 1;
+        s64 field = s64(element.representation & Element::exponent_mask) / hidden;
+        s64 mantissa = element.representation & Element::mantissa_mask;
+        s64 fixed = (mantissa | (field ? hidden : 0)) << (field ? field - 1 : 0);
+        return element.negative() ? -fixed : fixed;
+    }
+
+    /// Largest finite element, with the given sign.
+    static constexpr Element saturated(bool isNegative) {
+        Element out{Element::largest_finite};
+        out.set_negative(isNegative);
+        return out;
+    }
+
+    /// Quantise the first `count` values of `in` (at most `block_size`;
+    /// the rest of the block is zero).
+    ///
+    /// The shared scale comes from a scan for the largest exponent, and
+    /// is chosen so that the largest value lands in the top binade of
+    /// `Element`. Values much smaller than that lose precision or flush
+    /// to zero. Anything that would round past the largest finite
+    /// element saturates instead, and infinity or NaN anywhere in the
+    /// input makes the whole block NaN.
+    template<typename From>
+    static constexpr BlockFloat quantise(const From* in, size_t count = block_size, RoundingMode mode = RoundingMode::NearestEven, CounterRNG rng = {}, u64 first_index = 0) {
+        using FromRepr = decltype(in->representation);
+        BlockFloat out{};
+        if (count > block_size) count = block_size;
+
+        // Integer max of the raw exponent fields; no unpacking needed.
+        FromRepr largest = 0;
+        for (size_t i = 0; i < count; ++i) {
+            FromRepr field = in[i].representation & From::exponent_mask;
+            largest = field > largest ? field : largest;
+        }
+        if (largest == From::exponent_mask) {
+            out.scale = scale_not_a_number;
+            return out;
+        }
+
+        s32 largest_exponent = largest ? From{largest}.exponent() : From::exponent_min;
+        s32 shared_exponent = largest_exponent - Element::exponent_max;
+        if (shared_exponent < scale_exponent_min) shared_exponent = scale_exponent_min;
+        if (shared_exponent > scale_exponent_max) shared_exponent = scale_exponent_max;
+        out.scale = u8(shared_exponent + scale_bias);
+
+        for (size_t i = 0; i < count; ++i) {
+            WideFloat value = in[i].widen();
+            if (value.kind == WideFloat::Finite) value.exponent -= shared_exponent;
+            u64 random_bits = mode == RoundingMode::Stochastic ? rng(first_index + i) : 0;
+            Element element = Element::round_from(value, mode, random_bits);
+            if (!element.is_finite()) element = saturated(element.negative());
+            out.elements[i] = element;
+        }
+        return out;
+    }
+
+    /// Write the first `count` elements, scale applied, to `out`.
+    /// Stochastic rounding of element `i` uses `rng(first_index + i)`.
+    template<typename To>
+    constexpr void dequantise(To* out, size_t count = block_size, RoundingMode mode = RoundingMode::NearestEven, CounterRNG rng = {}, u64 first_index = 0) const {
+        if (count > block_size) count = block_size;
+        for (size_t i = 0; i < count; ++i) {
+            u64 random_bits = mode == RoundingMode::Stochastic ? rng(first_index + i) : 0;
+            out[i] = get<To>(i, mode, random_bits);
+        }
+    }
+};
+
+/// Quantise `count` values into `(count + block_size - 1) / block_size`
+/// blocks; the tail of the last block is zero. Stochastic rounding of
+/// value `i` uses `rng(first_index + i)`.
+template<typename Element, size_t block_size, typename From>
+void quantise(const From* in, BlockFloat<Element, block_size>* out, size_t count, RoundingMode mode = RoundingMode::NearestEven, CounterRNG rng = {}, u64 first_index = 0) {
+    for (size_t offset = 0; offset < count; offset += block_size, ++out) {
+        size_t remaining = count - offset;
+        *out = BlockFloat<Element, block_size>::quantise(in + offset, remaining, mode, rng, first_index + offset);
+    }
+}
+
+/// Dequantise the first `count` values held in consecutive blocks.
+/// Stochastic rounding of value `i` uses `rng(first_index + i)`.
+template<typename To, typename Element, size_t block_size>
+void dequantise(const BlockFloat<Element, block_size>* in, To* out, size_t count, RoundingMode mode = RoundingMode::NearestEven, CounterRNG rng = {}, u64 first_index = 0) {
+    for (size_t offset = 0; offset < count; offset += block_size, ++in)
+        in->dequantise(out + offset, count - offset, mode, rng, first_index + offset);
+}
+
+/// Dot product of two blocks as a wide value.
+///
+/// When `integer_dot` holds for the block type (i.e. FP8 E4M3 or FP4
+/// elements), products of elements are summed exactly in a 64-bit
+/// integer. Otherwise they are accumulated in a wide intermediate.
+template<typename Element, size_t block_size>
+constexpr WideFloat wide_dot(const BlockFloat<Element, block_size>& lhs, const BlockFloat<Element, block_size>& rhs) {
+    using Block = BlockFloat<Element, block_size>;
+    WideFloat out{};
+    if (lhs.is_not_a_number() || rhs.is_not_a_number()) {
+        out.kind = WideFloat::NotANumber;
+        return out;
+    }
+    s32 scale_exponent = lhs.scale_exponent() + rhs.scale_exponent();
+
+    if constexpr (Block::integer_dot) {
+        s64 sum = 0;
+        bool special = false;
+        for (size_t i = 0; i < block_size; ++i) {
+            special |= !lhs.elements[i].is_finite() | !rhs.elements[i].is_finite();
+            sum += Block::fixed_point(lhs.elements[i]) * Block::fixed_point(rhs.elements[i]);
+        }
+        // Infinity or NaN elements only exist if set by hand; take the
+        // slow path so they propagate like they should.
+        if (!special) return wide_from_integer(sum, 2 * Block::fixed_point_exponent + scale_exponent);
+    }
+
+    for (size_t i = 0; i < block_size; ++i)
+        out = wide_add(out, wide_mul(lhs.elements[i].widen(), rhs.elements[i].widen()));
+    if (out.kind == WideFloat::Finite) out.exponent += scale_exponent;
+    return out;
+}
+
+/// Dot product of two blocks, rounded once into `To`.
+template<typename To = binary32, typename Element, size_t block_size>
+constexpr To dot(const BlockFloat<Element, block_size>& lhs, const BlockFloat<Element, block_size>& rhs, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+    return To::round_from(wide_dot(lhs, rhs), mode, random_bits);
+}
+
+/// Dot product of `block_count` consecutive blocks, rounded once into
+/// `To`. Per-block sums are combined in a wide intermediate.
+template<typename To = binary32, typename Element, size_t block_size>
+constexpr To dot(const BlockFloat<Element, block_size>* lhs, const BlockFloat<Element, block_size>* rhs, size_t block_count, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+    WideFloat sum{};
+    for (size_t i = 0; i < block_count; ++i)
+        sum = wide_add(sum, wide_dot(lhs[i], rhs[i]));
+    return To::round_from(sum, mode, random_bits);
+}
+
+/// The OCP MX formats, with the standard block size of 32. Elements use
+/// the OCP encodings, so E4M3 reaches 448 and E2M1 reaches 6.
+using mxfp8_e4m3 = BlockFloat<float8_e4m3fn>;
+using mxfp8_e5m2 = BlockFloat<float8_e5m2>;
+using mxfp4 = BlockFloat<float4_e2m1fn>;
+
+#endif // MANTISSA_BLOCK_H
@@ -0,0 +1,79 @@
+#ifndef MANTISSA_COMPLEX_H
+#define MANTISSA_COMPLEX_H
+
+#include <mantissa.h>
+
+/// Complex number with real and imaginary parts in any `FloatImpl`
+/// format. Every operation on the parts is rounded to nearest, ties to
+/// even, just like hardware floats of the same format would be.
+template<typename Float>
+struct Complex {
+    Float real{};
+    Float imaginary{};
+
+    constexpr Complex() {}
+    constexpr Complex(Float real_part, Float imaginary_part = {})
+        : real(real_part), imaginary(imaginary_part) {}
+
+    static constexpr Float negate(Float value) {
+        value.set_negative(!value.negative());
+        return value;
+    }
+
+    static constexpr Float add(Float lhs, Float rhs) {
+        lhs.add(rhs, RoundingMode::NearestEven);
+        return lhs;
+    }
+
+    static constexpr Float sub(Float lhs, Float rhs) {
+        lhs.sub(rhs, RoundingMode::NearestEven);
+        return lhs;
+    }
+
+    static constexpr Float mul(Float lhs, Float rhs) {
+        lhs.mul(rhs, RoundingMode::NearestEven);
+        return lhs;
+    }
+
+    /// lhs * rhs + addend, rounded once.
+    static constexpr Float fma(Float lhs, Float rhs, Float addend) {
+        addend.fused_multiply_add(lhs, rhs);
+        return addend;
+    }
+
+    constexpr Complex conjugate() const {
+        return {real, negate(imaginary)};
+    }
+
+    constexpr Complex operator+(Complex rhs) const {
+        return {add(real, rhs.real), add(imaginary, rhs.imaginary)};
+    }
+
+    constexpr Complex operator-(Complex rhs) const {
+        return {sub(real, rhs.real), sub(imaginary, rhs.imaginary)};
+    }
+
+    /// Product using three real multiplications instead of four:
+    ///   (a + bi)(c + di) = (k1 - k3) + (k1 + k2)i
+    /// where k1 = c(a + b), k2 = a(d - c), k3 = b(c + d).
+    /// Multiplications are what's expensive in software, but note the
+    /// extra additions cost some accuracy when the parts cancel; see
+    /// `multiply_fused` for the accurate version.
+    constexpr Complex operator*(Complex rhs) const {
+        Float k1 = mul(rhs.real, add(real, imaginary));
+        Float k2 = mul(real, sub(rhs.imaginary, rhs.real));
+        Float k3 = mul(imaginary, add(rhs.real, rhs.imaginary));
+        return {sub(k1, k3), add(k1, k2)};
+    }
+
+    /// Product with each part computed as one multiplication and one
+    /// fused multiply-add.
+    constexpr Complex multiply_fused(Complex rhs) const {
+        return {
+            fma(real, rhs.real, negate(mul(imaginary, rhs.imaginary))),
+            fma(real, rhs.imaginary, mul(imaginary, rhs.real))
+        };
+    }
+};
+
+#endif // MANTISSA_COMPLEX_H
@@ -0,0 +1,194 @@
+#ifndef MANTISSA_EXPR_H
+#define MANTISSA_EXPR_H
+
+#include <type_traits>
+
+#include <mantissa.h>
+
+/// Opt-in expression templates for `FloatImpl` arithmetic.
+///
+/// Wrapping an operand with `lazy()` makes `+`, `-` and `*` build an
+/// expression tree at compile time instead of computing anything. The
+/// whole tree is evaluated when it is converted (assigned) to the float
+/// type, or passed to `evaluate()`:
+///
+///     binary32 result = lazy(a) * b + lazy(c) * d - e;
+///
+/// Intermediate results stay unpacked in a `WideFloat`, and only the
+/// final result is rounded into the float type. Each operation does
+/// still round to the wide 64-bit significand (plus sticky). Products
+/// of formats with up to 32 bits of precision fit that exactly, but
+/// sums of values far apart in magnitude don't, in any format: when a
+/// later operation cancels such a sum, its lost low bits are gone, and
+/// the result can be further from the exact one than strict evaluation
+/// would be. For binary32, `1 - (1 - 2^-100)` gives 2^-64 (strict
+/// evaluation gives 0, the exact answer is 2^-100).
+///
+/// Skipping the packing and unpacking between operations saves about a
+/// quarter of the time of rounding every operation (see
+/// bench/expression_time.cpp); the wide arithmetic itself dominates.
+///
+/// With `lazy_strict()`, every operation is rounded into the float type
+/// as it happens (packing it and unpacking it again), giving the same
+/// results as IEEE-754 arithmetic in that format, at the same cost.
+
+enum class Evaluation {
+    /// Only round the final result into the float type.
+    Fused,
+    /// Round after every operation, like IEEE-754 does.
+    Strict,
+};
+
+/// Leaf of an expression tree.
+template<typename Float, Evaluation evaluation = Evaluation::Fused>
+struct Lazy {
+    using FloatType = Float;
+    static constexpr Evaluation evaluation_mode = evaluation;
+
+    Float value;
+
+    constexpr WideFloat evaluate() const {
+        return value.widen();
+    }
+
+    constexpr Float round(RoundingMode = RoundingMode::NearestEven, u64 = 0) const {
+        return value;
+    }
+
+    constexpr operator Float() const {
+        return value;
+    }
+};
+
+struct AddOperation {
+    static constexpr WideFloat apply(WideFloat lhs, WideFloat rhs) {
+        return wide_add(lhs, rhs);
+    }
+};
+
+struct SubOperation {
+    static constexpr WideFloat apply(WideFloat lhs, WideFloat rhs) {
+        return wide_add(lhs, rhs.negated());
+    }
+};
+
+struct MulOperation {
+    static constexpr WideFloat apply(WideFloat lhs, WideFloat rhs) {
+        return wide_mul(lhs, rhs);
+    }
+};
+
+/// Interior node of an expression tree. Operands are held by value, so
+/// an expression may safely outlive the variables it was built from.
+template<typename Operation, typename Lhs, typename Rhs>
+struct Expression {
+    using FloatType = typename Lhs::FloatType;
+    static constexpr Evaluation evaluation_mode = Lhs::evaluation_mode;
+    static_assert(std::is_same_v<FloatType, typename Rhs::FloatType>, "Every operand of an expression must have the same float type.");
+    static_assert(evaluation_mode == Rhs::evaluation_mode, "Fused and strict expressions can not be mixed.");
+
+    Lhs lhs;
+    Rhs rhs;
+
+    constexpr WideFloat evaluate() const {
+        WideFloat out = Operation::apply(lhs.evaluate(), rhs.evaluate());
+        if constexpr (evaluation_mode == Evaluation::Strict)
+            out = FloatType::round_from(out).widen();
+        return out;
+    }
+
+    /// Evaluate, rounding the result into the float type. The last
+    /// operation is only rounded once, even for strict expressions.
+    constexpr FloatType round(RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) const {
+        return FloatType::round_from(Operation::apply(lhs.evaluate(), rhs.evaluate()), mode, random_bits);
+    }
+
+    constexpr operator FloatType() const {
+        return round();
+    }
+};
+
+/// Negation is exact, so it never rounds, even for strict expressions.
+template<typename Operand>
+struct NegatedExpression {
+    using FloatType = typename Operand::FloatType;
+    static constexpr Evaluation evaluation_mode = Operand::evaluation_mode;
+
+    Operand operand;
+
+    constexpr WideFloat evaluate() const {
+        return operand.evaluate().negated();
+    }
+
+    /// Every rounding mode is symmetric, so rounding the operand and
+    /// then negating it is the same as the other way around.
+    constexpr FloatType round(RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) const {
+        FloatType out = operand.round(mode, random_bits);
+        out.set_negative(!out.negative());
+        return out;
+    }
+
+    constexpr operator FloatType() const {
+        return round();
+    }
+};
+
+template<typename T>
+struct is_lazy : std::false_type {};
+template<typename Float, Evaluation evaluation>
+struct is_lazy<Lazy<Float, evaluation>> : std::true_type {};
+template<typename Operation, typename Lhs, typename Rhs>
+struct is_lazy<Expression<Operation, Lhs, Rhs>> : std::true_type {};
+template<typename Operand>
+struct is_lazy<NegatedExpression<Operand>> : std::true_type {};
+
+template<typename Float>
+constexpr Lazy<Float, Evaluation::Fused> lazy(Float value) {
+    return {value};
+}
+
+template<typename Float>
+constexpr Lazy<Float, Evaluation::Strict> lazy_strict(Float value) {
+    return {value};
+}
+
+/// Evaluate an expression, rounding the result as requested.
+template<typename Expr, std::enable_if_t<is_lazy<Expr>::value, int> = 0>
+constexpr typename Expr::FloatType evaluate(const Expr& expression, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+    return expression.round(mode, random_bits);
+}
+
+/// Build an expression node; a plain float on either side becomes a
+/// leaf with the same evaluation mode as the other side.
+template<typename Operation, typename Lhs, typename Rhs>
+constexpr auto make_expression(const Lhs& lhs, const Rhs& rhs) {
+    if constexpr (!is_lazy<Lhs>::value) {
+        using Leaf = Lazy<Lhs, Rhs::evaluation_mode>;
+        return Expression<Operation, Leaf, Rhs>{Leaf{lhs}, rhs};
+    } else if constexpr (!is_lazy<Rhs>::value) {
+        using Leaf = Lazy<Rhs, Lhs::evaluation_mode>;
+        return Expression<Operation, Lhs, Leaf>{lhs, Leaf{rhs}};
+    } else return Expression<Operation, Lhs, Rhs>{lhs, rhs};
+}
+
+template<typename Lhs, typename Rhs, std::enable_if_t<is_lazy<Lhs>::value || is_lazy<Rhs>::value, int> = 0>
+constexpr auto operator+(const Lhs& lhs, const Rhs& rhs) {
+    return make_expression<AddOperation>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, std::enable_if_t<is_lazy<Lhs>::value || is_lazy<Rhs>::value, int> = 0>
+constexpr auto operator-(const Lhs& lhs, const Rhs& rhs) {
+    return make_expression<SubOperation>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs, std::enable_if_t<is_lazy<Lhs>::value || is_lazy<Rhs>::value, int> = 0>
+constexpr auto operator*(const Lhs& lhs, const Rhs& rhs) {
+    return make_expression<MulOperation>(lhs, rhs);
+}
+
+template<typename Operand, std::enable_if_t<is_lazy<Operand>::value, int> = 0>
+constexpr NegatedExpression<Operand> operator-(const Operand& operand) {
+    return {operand};
+}
+
+#endif // MANTISSA_EXPR_H
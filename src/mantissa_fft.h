@@ -0,0 +1,152 @@
+#ifndef MANTISSA_FFT_H
+#define MANTISSA_FFT_H
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <mantissa.h>
+#include <mantissa_complex.h>
+
+/// Iterative, in-place, radix-2 decimation in time FFT where every
+/// arithmetic operation is done in the emulated `Float` format, for
+/// studying how FFT error behaves in reduced precision.
+///
+/// Twiddle factors are computed once per size (in double precision,
+/// then rounded into `Float`). Butterflies use fused multiply-adds:
+///   out0 = a + w*b  (two fmas per part)
+///   out1 = 2a - out0  (one fma per part)
+/// Large transforms split each stage's butterflies across threads;
+/// every butterfly in a stage is independent, so the result does not
+/// depend on the amount of threads.
+template<typename Float>
+struct FFT {
+    /// Transforms with less points than this run on the calling thread.
+    static constexpr size_t parallel_threshold = size_t(1) << 14;
+
+    size_t size{};
+    size_t log2_size{};
+    unsigned threads{1};
+    /// `twiddles[k] = exp(-2*pi*i*k/size)`, for `k < size / 2`.
+    std::vector<Complex<Float>> twiddles;
+
+    /// `size` must be a power of two. With `threads` of zero, use as
+    /// many threads as the hardware supports.
+    explicit FFT(size_t size_, unsigned threads_ = 0) : size(size_), threads(threads_) {
+        if (!threads) threads = std::thread::hardware_concurrency();
+        if (!threads) threads = 1;
+        if (!valid()) return;
+        while ((size_t(1) << log2_size) < size) ++log2_size;
+
+        static constexpr double pi = 3.14159265358979323846;
+        twiddles.resize(size / 2);
+        for (size_t k = 0; k < size / 2; ++k) {
+            double angle = -2.0 * pi * double(k) / double(size);
+            twiddles[k] = {from_double(std::cos(angle)), from_double(std::sin(angle))};
+        }
+    }
+
+    /// Return true iff the size is one this FFT can transform.
+    bool valid() const {
+        return size && !(size & (size - 1));
+    }
+
+    /// Transform `size` points in place. Returns false (and leaves the
+    /// data untouched) if the size isn't a power of two.
+    bool forward(Complex<Float>* data) const {
+        if (!valid()) return false;
+        transform(data, false);
+        return true;
+    }
+
+    /// Inverse transform, including the scaling by `1 / size`.
+    bool inverse(Complex<Float>* data) const {
+        if (!valid()) return false;
+        transform(data, true);
+        // Dividing by a power of two only changes the exponent; rounding
+        // matters only for results that become subnormal.
+        parallel_for(size, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                data[i].real = scale_down(data[i].real);
+                data[i].imaginary = scale_down(data[i].imaginary);
+            }
+        });
+        return true;
+    }
+
+private:
+    static Float from_double(double value) {
+        u64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return binary64{bits}.template convert<Float>();
+    }
+
+    Float scale_down(Float value) const {
+        WideFloat wide = value.widen();
+        if (wide.kind == WideFloat::Finite) wide.exponent -= s32(log2_size);
+        return Float::round_from(wide);
+    }
+
+    /// Call `work(begin, end)` over disjoint ranges that cover `[0, count)`.
+    template<typename Work>
+    void parallel_for(size_t count, Work work) const {
+        if (threads <= 1 || count < parallel_threshold / 2) {
+            work(size_t(0), count);
+            return;
+        }
+        std::vector<std::thread> workers;
+        size_t chunk = (count + threads - 1) / threads;
+        for (size_t begin = chunk; begin < count; begin += chunk) {
+            size_t end = begin + chunk < count ? begin + chunk : count;
+            workers.emplace_back(work, begin, end);
+        }
+        work(size_t(0), chunk < count ? chunk : count);
+        for (auto& worker : workers) worker.join();
+    }
+
+    void transform(Complex<Float>* data, bool inverse) const {
+        // Bit reversal permutation.
+        for (size_t i = 1, j = 0; i < size; ++i) {
+            size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) {
+                Complex<Float> tmp = data[i];
+                data[i] = data[j];
+                data[j] = tmp;
+            }
+        }
+
+        const Float two = Float::round_from(wide_from_integer(2));
+        for (size_t log2_half = 0; log2_half < log2_size; ++log2_half) {
+            size_t half = size_t(1) << log2_half;
+            size_t twiddle_shift = log2_size - log2_half - 1;
+            // Butterfly `j` of a stage pairs the `k`th element of group
+            // `j / half` with the one `half` elements after it.
+            parallel_for(size / 2, [&, half, log2_half, twiddle_shift](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j) {
+                    size_t k = j & (half - 1);
+                    size_t top = ((j >> log2_half) << (log2_half + 1)) | k;
+                    Complex<Float>& a = data[top];
+                    Complex<Float>& b = data[top + half];
+                    Complex<Float> w = twiddles[k << twiddle_shift];
+                    if (inverse) w = w.conjugate();
+
+                    Complex<Float> out0{
+                        Complex<Float>::fma(w.real, b.real, Complex<Float>::fma(Complex<Float>::negate(w.imaginary), b.imaginary, a.real)),
+                        Complex<Float>::fma(w.real, b.imaginary, Complex<Float>::fma(w.imaginary, b.real, a.imaginary))
+                    };
+                    Complex<Float> out1{
+                        Complex<Float>::fma(two, a.real, Complex<Float>::negate(out0.real)),
+                        Complex<Float>::fma(two, a.imaginary, Complex<Float>::negate(out0.imaginary))
+                    };
+                    a = out0;
+                    b = out1;
+                }
+            });
+        }
+    }
+};
+
+#endif // MANTISSA_FFT_H
@@ -0,0 +1,64 @@
+#ifndef MANTISSA_FORMAT_H
+#define MANTISSA_FORMAT_H
+
+#include <bitset>
+#include <iostream>
+#include <string>
+
+#include <mantissa.h>
+
+/// Text formatting for `FloatImpl` values; kept apart from mantissa.h
+/// so that arithmetic alone doesn't pull in the string and stream
+/// headers.
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding>
+std::string mantissa_string(FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding> value, Repr base = 10) {
+    using Float = FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding>;
+    Repr mtsa = value.mantissa_no_leading();
+    std::string out;
+    if (mtsa) {
+        while (mtsa) {
+            mtsa *= base;
+            out += '0' + ((mtsa & ~Float::mantissa_mask) >> exponent_bit);
+            mtsa &= Float::mantissa_mask;
+        }
+        return out;
+    }
+    return "0";
+}
+
+template<typename Repr, Repr sign_bit, Repr exponent_bit, Repr exponent_bias, Encoding encoding>
+std::string ascii_scientific(FloatImpl<Repr, sign_bit, exponent_bit, exponent_bias, encoding> value) {
+    std::string out;
+    if (value.negative()) out += '-';
+    if (value.exponent_zeroes()) {
+        // Zero
+        if (!value.mantissa()) {
+            out += '0';
+            return out;
+        }
+        // Subnormal
+        out += "0.";
+        out += mantissa_string(value);
+        out += "x2^-126";
+        return out;
+    }
+    // Infinity or NaN.
+    else if (!value.is_finite()) {
+        // Infinity
+        if (!value.mantissa()) {
+            out += "inf";
+            return out;
+        }
+        // Not a Number (NaN)
+        out += "NaN";
+        return out;
+    }
+    out += "1.";
+    out += mantissa_string(value);
+    out += "x2^";
+    out += std::to_string(value.exponent());
+    return out;
+}
+
+#endif // MANTISSA_FORMAT_H
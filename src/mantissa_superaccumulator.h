@@ -0,0 +1,223 @@
+#ifndef MANTISSA_SUPERACCUMULATOR_H
+#define MANTISSA_SUPERACCUMULATOR_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include <mantissa.h>
+
+/// Long fixed-point (Kulisch) accumulator, wide enough to hold any sum
+/// of `Float` values, or of products of two `Float` values, exactly.
+/// Sums and dot products are correct to the last bit no matter the
+/// order of the terms; the only rounding happens in `round()`.
+///
+/// The fixed-point number is stored in carry-save form: every limb is a
+/// signed 64-bit integer holding a 32-bit digit, so adding a term only
+/// touches the few limbs it overlaps, with no carry propagation. The
+/// upper 32 bits of each limb absorb carries, which are only propagated
+/// (see `normalise()`) every few hundred million terms, when merging,
+/// and when rounding.
+///
+/// For binary32 that is 21 limbs (672 bits of digits); binary64 needs
+/// 137.
+/// Accumulators are cheap to copy and can be merged, so each thread can
+/// accumulate its own share of the terms and merge at the end.
+template<typename Float>
+struct SuperAccumulator {
+    static_assert(Float::encoding == Encoding::IEEE, "Infinity and NaN are only tracked for IEEE-754 formats.");
+
+    static constexpr s32 limb_bits = 32;
+    static constexpr s64 limb_mask = (s64(1) << limb_bits) - 1;
+
+    /// Exponent of the smallest subnormal; bit zero of the accumulator
+    /// is worth the square of it.
+    static constexpr s32 exponent_lowest = Float::exponent_min - (Float::precision - 1);
+    static constexpr s32 position_bias = -2 * exponent_lowest;
+    /// Products reach just below 2^(2 * (exponent_max + 1)).
+    static constexpr s32 position_max = 2 * (Float::exponent_max + 1) + position_bias;
+    /// A product term spans this many digits (plus one for alignment).
+    static constexpr size_t term_limbs = (2 * Float::precision + limb_bits - 1) / limb_bits + 1;
+    static constexpr size_t limb_count = position_max / limb_bits + term_limbs + 1;
+
+    /// Each term changes a limb by less than 2^33, so limbs stay far
+    /// from overflowing for this many terms between normalisations.
+    static constexpr u64 terms_between_normalisation = u64(1) << 29;
+
+    s64 limbs[limb_count]{};
+    u64 pending{};
+    bool not_a_number{false};
+    bool positive_infinity{false};
+    bool negative_infinity{false};
+
+    /// Exact integer significand and exponent (`significand *
+    /// 2^exponent`) of a finite value, without any branches.
+    static constexpr u64 significand_of(Float value) {
+        u64 field = (value.representation & Float::exponent_mask) >> (Float::precision - 1);
+        return u64(value.representation & Float::mantissa_mask) | (u64(field != 0) << (Float::precision - 1));
+    }
+
+    static constexpr s32 exponent_of(Float value) {
+        u64 field = (value.representation & Float::exponent_mask) >> (Float::precision - 1);
+        return s32(field | (field == 0)) - 1 + Float::exponent_min - (Float::precision - 1);
+    }
+
+    /// Record infinity or NaN; return true iff the value was either.
+    constexpr bool special(Float value, bool isNegative) {
+        if (!value.exponent_ones()) return false;
+        if (value.mantissa_no_leading()) not_a_number = true;
+        else if (isNegative) negative_infinity = true;
+        else positive_infinity = true;
+        return true;
+    }
+
+    /// Add `hi:lo * 2^position` (relative to bit zero of the
+    /// accumulator), subtracting instead when `isNegative`.
+    constexpr void accumulate(bool isNegative, u64 hi, u64 lo, s32 position) {
+        size_t index = size_t(position) / limb_bits;
+        s32 shift = position % limb_bits;
+        s64 sign = isNegative ? -1 : 1;
+        u64 chunks[4] = {lo & u64(limb_mask), lo >> limb_bits, hi & u64(limb_mask), hi >> limb_bits};
+        for (size_t k = 0; k + 1 < term_limbs; ++k) {
+            u64 shifted = chunks[k] << shift;
+            limbs[index + k] += sign * s64(shifted & u64(limb_mask));
+            limbs[index + k + 1] += sign * s64(shifted >> limb_bits);
+        }
+        if (++pending == terms_between_normalisation) normalise();
+    }
+
+    /// Add a value, exactly.
+    constexpr void add(Float value) {
+        bool isNegative = value.negative();
+        if (special(value, isNegative)) return;
+        accumulate(isNegative, 0, significand_of(value), exponent_of(value) + position_bias);
+    }
+
+    /// Add the product of two values, exactly.
+    constexpr void add_product(Float lhs, Float rhs) {
+        bool isNegative = lhs.negative() != rhs.negative();
+        bool lhs_special = special(lhs, isNegative);
+        bool rhs_special = special(rhs, isNegative);
+        if (lhs_special || rhs_special) {
+            // Infinity times zero is NaN.
+            if (!significand_of(lhs) || !significand_of(rhs)) not_a_number = true;
+            return;
+        }
+        u64 hi{};
+        u64 lo{};
+        if constexpr (Float::precision <= 32) lo = significand_of(lhs) * significand_of(rhs);
+        else multiply_wide(significand_of(lhs), significand_of(rhs), hi, lo);
+        accumulate(isNegative, hi, lo, exponent_of(lhs) + exponent_of(rhs) + position_bias);
+    }
+
+    /// Propagate carries, so every limb but the top one holds a digit in
+    /// [0, 2^32) and the top one holds the (signed) rest.
+    constexpr void normalise() {
+        for (size_t i = 0; i + 1 < limb_count; ++i) {
+            s64 carry = limbs[i] >> limb_bits;
+            limbs[i] &= limb_mask;
+            limbs[i + 1] += carry;
+        }
+        pending = 0;
+    }
+
+    /// Add everything accumulated by another accumulator, i.e. one used
+    /// by another thread.
+    constexpr void merge(SuperAccumulator other) {
+        normalise();
+        other.normalise();
+        for (size_t i = 0; i < limb_count; ++i)
+            limbs[i] += other.limbs[i];
+        not_a_number |= other.not_a_number;
+        positive_infinity |= other.positive_infinity;
+        negative_infinity |= other.negative_infinity;
+        pending = 1;
+    }
+
+    /// The exact sum, as a wide value with sticky.
+    constexpr WideFloat widen() const {
+        WideFloat out{};
+        if (not_a_number || (positive_infinity && negative_infinity)) {
+            out.kind = WideFloat::NotANumber;
+            return out;
+        }
+        if (positive_infinity || negative_infinity) {
+            out.kind = WideFloat::Infinity;
+            out.negative = negative_infinity;
+            return out;
+        }
+
+        SuperAccumulator value = *this;
+        value.normalise();
+        if (value.limbs[limb_count - 1] < 0) {
+            out.negative = true;
+            for (auto& limb : value.limbs) limb = -limb;
+            value.normalise();
+        }
+
+        size_t top = limb_count;
+        while (top && !value.limbs[top - 1]) --top;
+        if (!top) return out;
+        --top;
+
+        // Digits don't overlap once normalised, so the significand is
+        // just the leading 64 bits of their concatenation.
+        u64 significand = u64(value.limbs[top]);
+        s32 bits = 64 - count_leading_zeros(significand);
+        s64 lowest_position = s64(top) * limb_bits;
+        size_t index = top;
+        while (index && bits + limb_bits <= 64) {
+            significand = (significand << limb_bits) | u64(value.limbs[--index]);
+            bits += limb_bits;
+            lowest_position -= limb_bits;
+        }
+        bool sticky = false;
+        if (index && bits < 64) {
+            s32 take = 64 - bits;
+            u64 next = u64(value.limbs[--index]);
+            significand = (significand << take) | (next >> (limb_bits - take));
+            sticky = (next & ((u64(1) << (limb_bits - take)) - 1)) != 0;
+            bits = 64;
+            lowest_position -= take;
+        }
+        while (index) sticky |= value.limbs[--index] != 0;
+
+        out.kind = WideFloat::Finite;
+        out.sticky = sticky;
+        out.significand = significand << (64 - bits);
+        out.exponent = s32(lowest_position + bits - 1 - position_bias);
+        return out;
+    }
+
+    /// Round the exact sum, once, into any format.
+    template<typename To = Float>
+    constexpr To round(RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) const {
+        return To::round_from(widen(), mode, random_bits);
+    }
+};
+
+static_assert(SuperAccumulator<binary32>::limb_count == 21, "Keep the limb count in the documentation up to date.");
+static_assert(SuperAccumulator<binary64>::limb_count == 137, "Keep the limb count in the documentation up to date.");
+
+/// Sum of `count` values, correctly rounded into `To`. `random_bits`
+/// is only used by `RoundingMode::Stochastic`.
+template<typename To = void, typename Float>
+constexpr auto exact_sum(const Float* values, size_t count, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+    using Result = std::conditional_t<std::is_void_v<To>, Float, To>;
+    SuperAccumulator<Float> accumulator{};
+    for (size_t i = 0; i < count; ++i)
+        accumulator.add(values[i]);
+    return accumulator.template round<Result>(mode, random_bits);
+}
+
+/// Dot product of `count` pairs of values, correctly rounded into `To`.
+/// `random_bits` is only used by `RoundingMode::Stochastic`.
+template<typename To = void, typename Float>
+constexpr auto exact_dot(const Float* lhs, const Float* rhs, size_t count, RoundingMode mode = RoundingMode::NearestEven, u64 random_bits = 0) {
+    using Result = std::conditional_t<std::is_void_v<To>, Float, To>;
+    SuperAccumulator<Float> accumulator{};
+    for (size_t i = 0; i < count; ++i)
+        accumulator.add_product(lhs[i], rhs[i]);
+    return accumulator.template round<Result>(mode, random_bits);
+}
+
+#endif // MANTISSA_SUPERACCUMULATOR_H
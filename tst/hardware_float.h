@@ -0,0 +1,43 @@
+#ifndef MANTISSA_TST_HARDWARE_FLOAT_H
+#define MANTISSA_TST_HARDWARE_FLOAT_H
+
+#include <cstring>
+
+#include <mantissa.h>
+
+/// Helpers for tests that check results against hardware floats.
+
+inline float float_from_bits(u32 bits) {
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline u32 bits_from_float(float f) {
+    u32 bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+inline double double_from_bits(u64 bits) {
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+inline u64 bits_from_double(double d) {
+    u64 bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+/// Random binary32 operands for the `index`th check. Every other pair
+/// shares the exponent of the left hand side, so cancellation happens.
+inline void random_operands(CounterRNG rng, u64 index, u32& lhs, u32& rhs) {
+    u64 bits = rng(index);
+    lhs = u32(bits);
+    rhs = u32(bits >> 32);
+    if (index & 1) rhs = (lhs & 0xff800000) | (rhs & 0x807fffff);
+}
+
+#endif // MANTISSA_TST_HARDWARE_FLOAT_H
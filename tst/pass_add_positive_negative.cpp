@@ -1,10 +1,10 @@
-#include <mantissa.h>
+#include <mantissa_format.h>
 
 int main() {
     binary32 number0{2.1f};
     binary32 number1{-4.2f};
     binary32 sum = number0 + number1;
     float fsum = sum;
-    std::cout << sum.ascii_scientific() << '\n';
+    std::cout << ascii_scientific(sum) << '\n';
     MANTISSA_VALIDATE(fsum == -2.1f);
 }
@@ -0,0 +1,32 @@
+#include <mantissa_block.h>
+
+int main() {
+    // E4M3 blocks take the exact integer path, E5M2 blocks the wide one;
+    // with exactly representable values, both must match the exact sum.
+    binary32 lhs[64];
+    binary32 rhs[64];
+    float expected = 0;
+    for (int i = 0; i < 64; ++i) {
+        float l = float((i % 9) - 4) * 0x1p-3f;
+        float r = float((i % 7) - 3) * 0x1p5f;
+        lhs[i] = binary32{l};
+        rhs[i] = binary32{r};
+        expected += l * r;
+    }
+
+    mxfp8_e4m3 lhs_e4m3[2];
+    mxfp8_e4m3 rhs_e4m3[2];
+    quantise(lhs, lhs_e4m3, 64);
+    quantise(rhs, rhs_e4m3, 64);
+    binary32 e4m3_result = dot(lhs_e4m3, rhs_e4m3, 2);
+
+    mxfp8_e5m2 lhs_e5m2[2];
+    mxfp8_e5m2 rhs_e5m2[2];
+    quantise(lhs, lhs_e5m2, 64);
+    quantise(rhs, rhs_e5m2, 64);
+    binary32 e5m2_result = dot(lhs_e5m2, rhs_e5m2, 2);
+
+    static_assert(mxfp8_e4m3::integer_dot, "E4M3 blocks should accumulate in an integer.");
+    static_assert(!mxfp8_e5m2::integer_dot, "E5M2 products don't fit in an integer.");
+    MANTISSA_VALIDATE(float(e4m3_result) == expected && float(e5m2_result) == expected);
+}
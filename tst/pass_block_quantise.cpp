@@ -0,0 +1,24 @@
+#include <mantissa_block.h>
+
+int main() {
+    // Small integers times a common power of two fit E4M3 exactly, so
+    // they should survive a round trip untouched.
+    binary32 in[40];
+    for (int i = 0; i < 40; ++i)
+        in[i] = binary32{float((i % 15) - 7) * 0x1p-20f};
+
+    mxfp8_e4m3 blocks[2];
+    quantise(in, blocks, 40);
+
+    binary32 out[40];
+    dequantise(blocks, out, 40);
+    for (int i = 0; i < 40; ++i)
+        if (out[i].representation != in[i].representation) return -1;
+
+    // The largest magnitude is 7 * 2^-20, so it lands at the top of the
+    // E4M3 exponent range: 7 * 2^-20 = 1.75 * 2^-18 = 1.75 * 2^8 * 2^-26.
+    // The tail of the second block is zero.
+    MANTISSA_VALIDATE(blocks[0].scale_exponent() == -26
+                      && blocks[1].elements[8].representation == 0
+                      && blocks[1].elements[31].representation == 0);
+}
@@ -0,0 +1,36 @@
+#include <mantissa_block.h>
+
+int main() {
+    // 1.125 is exact in E4M3, and a quarter of the way from 1 to 1.5 in
+    // E2M1, so dequantising it into E2M1 should round up a quarter of
+    // the time, the same way however the blocks are split up.
+    static constexpr size_t count = 1 << 12;
+    static binary32 in[count];
+    static mxfp8_e4m3 blocks[count / 32];
+    static float4_e2m1fn out[count];
+    static float4_e2m1fn again[count];
+    for (auto& value : in) value = binary32{1.125f};
+    quantise(in, blocks, count);
+
+    CounterRNG rng{27};
+    dequantise(blocks, out, count, RoundingMode::Stochastic, rng);
+    dequantise(blocks, again, count / 2, RoundingMode::Stochastic, rng);
+    dequantise(blocks + count / 64, again + count / 2, count / 2, RoundingMode::Stochastic, rng, count / 2);
+
+    size_t rounded_up = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (out[i].representation == 0x3) ++rounded_up;
+        else if (out[i].representation != 0x2) return -1;
+        if (out[i].representation != again[i].representation) return -1;
+    }
+
+    // Dot products take their random bits directly.
+    binary32 one{1.0f};
+    mxfp8_e4m3 lhs = mxfp8_e4m3::quantise(in, 1);
+    mxfp8_e4m3 rhs = mxfp8_e4m3::quantise(&one, 1);
+    float4_e2m1fn up = dot<float4_e2m1fn>(lhs, rhs, RoundingMode::Stochastic, 0);
+    float4_e2m1fn down = dot<float4_e2m1fn>(lhs, rhs, RoundingMode::Stochastic, ~u64(0));
+
+    MANTISSA_VALIDATE(rounded_up > count / 4 - count / 64 && rounded_up < count / 4 + count / 64
+                      && up.representation == 0x3 && down.representation == 0x2);
+}
@@ -0,0 +1,15 @@
+#include <mantissa_complex.h>
+
+int main() {
+    // (1.5 + 2i)(-3 + 0.25i) = -5 - 5.625i, exact in binary32 either way.
+    Complex<binary32> lhs{binary32{1.5f}, binary32{2.0f}};
+    Complex<binary32> rhs{binary32{-3.0f}, binary32{0.25f}};
+    Complex<binary32> gauss = lhs * rhs;
+    Complex<binary32> fused = lhs.multiply_fused(rhs);
+    Complex<binary32> sum = lhs + rhs;
+    Complex<binary32> conjugate = lhs.conjugate();
+    MANTISSA_VALIDATE(float(gauss.real) == -5.0f && float(gauss.imaginary) == -5.625f
+                      && float(fused.real) == -5.0f && float(fused.imaginary) == -5.625f
+                      && float(sum.real) == -1.5f && float(sum.imaginary) == 2.25f
+                      && float(conjugate.imaginary) == -2.0f);
+}
@@ -0,0 +1,47 @@
+#include <mantissa.h>
+
+#include "hardware_float.h"
+
+static bool is_nan(binary32 value) {
+    return value.exponent_ones() && value.mantissa_no_leading();
+}
+
+static bool matches(binary32 value, float expected) {
+    if (expected != expected) return is_nan(value);
+    return value.representation == bits_from_float(expected);
+}
+
+int main() {
+    // The constant-time kernels must match hardware binary32 arithmetic
+    // bit-for-bit, special values and subnormals included (NaN results
+    // only need to be some NaN).
+    static const u32 specials[] = {
+        0x00000000, 0x80000000, 0x7f800000, 0xff800000, 0x7fc00000,
+        0x00000001, 0x807fffff, 0x00800000, 0x7f7fffff, 0x3f800000,
+    };
+    static constexpr u64 special_count = sizeof(specials) / sizeof(specials[0]);
+    CounterRNG rng{31};
+    for (u64 i = 0; i < 200000; ++i) {
+        u32 lhs_bits{};
+        u32 rhs_bits{};
+        random_operands(rng, i, lhs_bits, rhs_bits);
+        if (i < special_count * special_count) {
+            lhs_bits = specials[i / special_count];
+            rhs_bits = specials[i % special_count];
+        }
+        float lhs = float_from_bits(lhs_bits);
+        float rhs = float_from_bits(rhs_bits);
+
+        binary32 sum{lhs_bits};
+        sum.add_constant_time(binary32{rhs_bits});
+        binary32 difference{lhs_bits};
+        difference.sub_constant_time(binary32{rhs_bits});
+        binary32 product{lhs_bits};
+        product.mul_constant_time(binary32{rhs_bits});
+
+        if (!matches(sum, lhs + rhs)) return -1;
+        if (!matches(difference, lhs - rhs)) return -1;
+        if (!matches(product, lhs * rhs)) return -1;
+    }
+    MANTISSA_VALIDATE(true);
+}
@@ -0,0 +1,34 @@
+#include <mantissa.h>
+#include <mantissa_complex.h>
+#include <mantissa_expr.h>
+#include <mantissa_superaccumulator.h>
+
+int main() {
+    // Everything but the legacy `mul` can be evaluated at compile time.
+    constexpr binary32 one{u32(0x3f800000)};
+    constexpr binary32 two{u32(0x40000000)};
+    constexpr binary32 sum = one + one;
+    constexpr binary32 difference = two - one;
+    static_assert(sum.representation == 0x40000000);
+    static_assert(difference.representation == 0x3f800000);
+
+    constexpr binary32 rounded = [&] {
+        binary32 out = two;
+        out.mul(two, RoundingMode::NearestEven);
+        out.fused_multiply_add(two, two);
+        return out;
+    }();
+    static_assert(rounded.representation == 0x41000000);
+    static_assert(two.convert<bfloat16>().representation == 0x4000);
+
+    constexpr Complex<binary32> product = Complex<binary32>{one, two} * Complex<binary32>{two, one};
+    static_assert(product.real.representation == 0 && product.imaginary.representation == 0x40a00000);
+
+    constexpr binary32 expression = lazy(one) * two + two;
+    static_assert(expression.representation == 0x40800000);
+
+    constexpr binary32 values[] = {one, two, one};
+    static_assert(exact_sum(values, 3).representation == 0x40800000);
+
+    MANTISSA_VALIDATE(true);
+}
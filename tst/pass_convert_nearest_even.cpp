@@ -0,0 +1,21 @@
+#include <mantissa.h>
+
+int main() {
+    // bfloat16 keeps 7 mantissa bits, so 2^-8 is exactly half an ULP at 1.0.
+    binary32 tie_even{1.0f + 0x1p-8f};
+    binary32 tie_odd{1.0f + 0x1p-7f + 0x1p-8f};
+    binary32 above_half{1.0f + 0x1p-8f + 0x1p-20f};
+    binary32 huge{3.0e38f};
+    bfloat16 a = tie_even.convert<bfloat16>();
+    bfloat16 b = tie_odd.convert<bfloat16>();
+    bfloat16 c = above_half.convert<bfloat16>();
+    bfloat16 d = above_half.convert<bfloat16>(RoundingMode::TowardZero);
+    bfloat16 e = huge.convert<binary16>().convert<bfloat16>();
+    binary32 back = c.convert<binary32>();
+    MANTISSA_VALIDATE(a.representation == 0x3f80
+                      && b.representation == 0x3f82
+                      && c.representation == 0x3f81
+                      && d.representation == 0x3f80
+                      && e.representation == 0x7f80
+                      && float(back) == 1.0f + 0x1p-7f);
+}
@@ -0,0 +1,34 @@
+#include <mantissa_superaccumulator.h>
+
+int main() {
+    // Operands with short mantissas and a narrow exponent range, so that
+    // the sum of products is exact in double precision; the exact dot
+    // product rounded once must then match it.
+    static constexpr size_t count = 4096;
+    static binary32 lhs[count];
+    static binary32 rhs[count];
+    double expected = 0;
+    CounterRNG rng{32};
+    for (size_t i = 0; i < count; ++i) {
+        u64 bits = rng(i);
+        float l = float(s32(bits & 0x1ff) - 256) * float(1 << ((bits >> 9) & 7)) * 0x1p-8f;
+        float r = float(s32((bits >> 12) & 0x1ff) - 256) * float(1 << ((bits >> 21) & 7)) * 0x1p-9f;
+        lhs[i] = binary32{l};
+        rhs[i] = binary32{r};
+        expected += double(l) * double(r);
+    }
+    binary32 result = exact_dot(lhs, rhs, count);
+
+    // Splitting the terms between two accumulators (as two threads
+    // would), in different orders, and merging gives the same result.
+    SuperAccumulator<binary32> first{};
+    SuperAccumulator<binary32> second{};
+    for (size_t i = 0; i < count; i += 2)
+        first.add_product(lhs[i], rhs[i]);
+    for (size_t i = count - 1; i < count; i -= 2)
+        second.add_product(lhs[i], rhs[i]);
+    first.merge(second);
+    binary32 merged = first.round();
+
+    MANTISSA_VALIDATE(float(result) == float(expected) && merged.representation == result.representation);
+}
@@ -0,0 +1,29 @@
+#include <mantissa_superaccumulator.h>
+
+int main() {
+    // Naive summation loses the 1 entirely, in either order.
+    binary32 values[] = {binary32{1.0e30f}, binary32{1.0f}, binary32{-1.0e30f}, binary32{0x1p-149f}};
+    binary32 sum = exact_sum(values, 4);
+
+    // Two quarter-ULP terms vanish when added to 1 one at a time, but
+    // their exact sum is kept; rounded into binary64, 1 + 2^-24 is exact.
+    binary32 tiny_halves[] = {binary32{1.0f}, binary32{0x1p-25f}, binary32{0x1p-25f}};
+    binary64 wide = exact_sum<binary64>(tiny_halves, 3);
+
+    // Infinities of both signs make NaN.
+    SuperAccumulator<binary32> infinities{};
+    infinities.add(binary32{u32(0x7f800000)});
+    infinities.add(binary32{u32(0xff800000)});
+    binary32 not_a_number = infinities.round();
+
+    // 1 + 2^-30 is 2^-7 of an ULP above 1; stochastic rounding only
+    // goes up when the random bits fall below that fraction.
+    binary32 above_one[] = {binary32{1.0f}, binary32{0x1p-30f}};
+    binary32 up = exact_sum(above_one, 2, RoundingMode::Stochastic, u64(1) << 50);
+    binary32 down = exact_sum(above_one, 2, RoundingMode::Stochastic, u64(1) << 60);
+
+    MANTISSA_VALIDATE(float(sum) == 1.0f
+                      && up.representation == 0x3f800001 && down.representation == 0x3f800000
+                      && wide.representation == 0x3ff0000010000000
+                      && not_a_number.exponent_ones() && not_a_number.mantissa_no_leading());
+}
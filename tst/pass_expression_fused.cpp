@@ -0,0 +1,26 @@
+#include <mantissa_expr.h>
+
+int main() {
+    // (1 + 2^-12)^2 - 1 = 2^-11 + 2^-24. Rounding the product first loses
+    // the 2^-24 (an exact tie at 1.0, broken toward even), rounding only
+    // once keeps it.
+    binary32 a{1.0f + 0x1p-12f};
+    binary32 one{1.0f};
+
+    binary32 fused = lazy(a) * a - one;
+    binary32 strict = lazy_strict(a) * a - one;
+    binary32 rounded_down = evaluate(lazy(a) * a - one - binary32{0x1p-11f}, RoundingMode::TowardZero);
+
+    // 1 - 2^-100 doesn't fit the 64-bit wide significand, so cancelling
+    // it against 1 exposes the rounding of the intermediate: the exact
+    // answer is 2^-100, fused evaluation gives 2^-64 and strict gives 0.
+    binary32 tiny{0x1p-100f};
+    binary32 cancelled = lazy(one) - (lazy(one) - tiny);
+    binary32 cancelled_strict = lazy_strict(one) - (lazy_strict(one) - tiny);
+
+    MANTISSA_VALIDATE(float(fused) == 0x1p-11f + 0x1p-24f
+                      && float(strict) == 0x1p-11f
+                      && float(rounded_down) == 0x1p-24f
+                      && float(cancelled) == 0x1p-64f
+                      && float(cancelled_strict) == 0.0f);
+}
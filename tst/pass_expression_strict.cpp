@@ -0,0 +1,29 @@
+#include <mantissa_expr.h>
+
+#include "hardware_float.h"
+
+int main() {
+    // Strict expressions round after every operation, so they must match
+    // hardware binary32 arithmetic done one step at a time.
+    CounterRNG rng{29};
+    for (u64 i = 0; i < 20000; ++i) {
+        u64 first = rng(2 * i);
+        u64 second = rng(2 * i + 1);
+        // Keep values in a modest range so the test exercises rounding
+        // rather than overflow.
+        float a = float_from_bits((u32(first) & 0x807fffff) | 0x3f000000);
+        float b = float_from_bits((u32(first >> 32) & 0x807fffff) | 0x3f800000);
+        float c = float_from_bits((u32(second) & 0x807fffff) | 0x3f000000);
+        float d = float_from_bits((u32(second >> 32) & 0x807fffff) | 0x3f800000);
+        float e = float_from_bits((u32(first ^ second) & 0x807fffff) | 0x3f800000);
+
+        volatile float ab = a * b;
+        volatile float cd = c * d;
+        volatile float sum = ab + cd;
+        float expected = sum - e;
+
+        binary32 result = lazy_strict(binary32{a}) * binary32{b} + lazy_strict(binary32{c}) * binary32{d} - binary32{e};
+        if (result.representation != bits_from_float(expected)) return -1;
+    }
+    MANTISSA_VALIDATE(true);
+}
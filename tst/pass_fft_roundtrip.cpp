@@ -0,0 +1,55 @@
+#include <mantissa_fft.h>
+#include <cmath>
+
+int main() {
+    static constexpr size_t size = 1 << 15;
+    std::vector<Complex<binary32>> data(size);
+    std::vector<Complex<binary32>> original(size);
+    CounterRNG rng{1};
+    for (size_t i = 0; i < size; ++i) {
+        u64 bits = rng(i);
+        float real = float(bits & 0xffff) / 65536.0f - 0.5f;
+        float imaginary = float((bits >> 16) & 0xffff) / 65536.0f - 0.5f;
+        data[i] = {binary32{real}, binary32{imaginary}};
+    }
+    original = data;
+
+    // Threaded and single-threaded transforms must agree bit for bit.
+    FFT<binary32> single{size, 1};
+    FFT<binary32> threaded{size, 4};
+    std::vector<Complex<binary32>> copy = data;
+    if (!threaded.forward(data.data()) || !single.forward(copy.data())) return -1;
+    for (size_t i = 0; i < size; ++i)
+        if (data[i].real.representation != copy[i].real.representation
+            || data[i].imaginary.representation != copy[i].imaginary.representation)
+            return -1;
+
+    // Check one bin against a direct DFT in double precision.
+    static constexpr size_t bin = 12345;
+    double real = 0;
+    double imaginary = 0;
+    for (size_t i = 0; i < size; ++i) {
+        double angle = -2.0 * 3.14159265358979323846 * double((bin * i) % size) / double(size);
+        float re = original[i].real;
+        float im = original[i].imaginary;
+        real += re * std::cos(angle) - im * std::sin(angle);
+        imaginary += re * std::sin(angle) + im * std::cos(angle);
+    }
+    float fft_real = data[bin].real;
+    float fft_imaginary = data[bin].imaginary;
+    if (std::fabs(fft_real - real) > 1e-3 || std::fabs(fft_imaginary - imaginary) > 1e-3) return -1;
+
+    // The inverse should bring back the input to within a few ULPs.
+    threaded.inverse(data.data());
+    double worst = 0;
+    for (size_t i = 0; i < size; ++i) {
+        float re = data[i].real;
+        float im = data[i].imaginary;
+        float original_re = original[i].real;
+        float original_im = original[i].imaginary;
+        worst = std::fmax(worst, std::fabs(re - original_re));
+        worst = std::fmax(worst, std::fabs(im - original_im));
+    }
+    FFT<binary32> odd{size - 1};
+    MANTISSA_VALIDATE(worst < 1e-5 && !odd.valid() && !odd.forward(data.data()));
+}
@@ -0,0 +1,34 @@
+#include <mantissa.h>
+
+int main() {
+    // E2M1 has a single mantissa bit, so the quiet NaN (0x7) is the only
+    // NaN there is; 0x6 is infinity, 0x5 the largest finite value (3).
+    float4_e2m1 infinity{u8(0x6)};
+    float4_e2m1 negative_infinity{u8(0xe)};
+    float4_e2m1 three{u8(0x5)};
+    float4_e2m1 half{u8(0x1)};
+    float4_e2m1 one_and_a_half{u8(0x3)};
+
+    float4_e2m1 not_a_number = infinity;
+    not_a_number.add(negative_infinity, RoundingMode::NearestEven);
+    float4_e2m1 converted = binary32{u32(0x7fc00000)}.convert<float4_e2m1>();
+
+    float4_e2m1 overflow = three;
+    overflow.add(three, RoundingMode::NearestEven);
+    float4_e2m1 saturated = three;
+    saturated.add(three, RoundingMode::TowardZero);
+
+    // 0.5 * 0.5 = 0.25 is a tie between zero and 0.5; 0.5 * 1.5 = 0.75
+    // is a tie between 0.5 and 1. Both go to the even mantissa.
+    float4_e2m1 quarter = half;
+    quarter.mul(half, RoundingMode::NearestEven);
+    float4_e2m1 three_quarters = half;
+    three_quarters.mul(one_and_a_half, RoundingMode::NearestEven);
+
+    MANTISSA_VALIDATE(not_a_number.representation == 0x7
+                      && converted.representation == 0x7
+                      && overflow.representation == 0x6
+                      && saturated.representation == 0x5
+                      && quarter.representation == 0x0
+                      && three_quarters.representation == 0x2);
+}
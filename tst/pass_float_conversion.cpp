@@ -0,0 +1,17 @@
+#include <mantissa.h>
+
+int main() {
+    // Formats other than binary32 round to and from hardware floats
+    // instead of reinterpreting their bits.
+    bfloat16 one = bfloat16::from_float(1.0f);
+    binary64 third = binary64::from_float(1.0f / 3.0f);
+    float8_e4m3 rounded = float8_e4m3::from_float(1.0625f);
+    binary16 overflow = binary16::from_float(1.0e6f);
+
+    MANTISSA_VALIDATE(one.representation == 0x3f80
+                      && one.to_float() == 1.0f
+                      && third.to_float() == 1.0f / 3.0f
+                      && rounded.representation == 0x38
+                      && overflow.representation == 0x7c00
+                      && binary32::from_float(4.2f).to_float() == 4.2f);
+}
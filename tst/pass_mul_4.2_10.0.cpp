@@ -1,4 +1,4 @@
-#include <mantissa.h>
+#include <mantissa_format.h>
 #include <cstring>
 #include <cstdint>
 #include <iostream>
@@ -0,0 +1,37 @@
+#include <mantissa_block.h>
+
+int main() {
+    // OCP E4M3 has no infinity; only 0x7f is NaN, and the top binade is
+    // finite, up to 448.
+    float8_e4m3fn largest = float8_e4m3fn::from_float(448.0f);
+    float8_e4m3fn top_binade = float8_e4m3fn::from_float(256.0f);
+    float8_e4m3fn overflow = float8_e4m3fn::from_float(1.0e6f);
+    float8_e4m3fn infinity = binary32{u32(0xff800000)}.convert<float8_e4m3fn>();
+    float8_e4m3fn not_a_number = binary32{u32(0x7fc00000)}.convert<float8_e4m3fn>();
+    // 472 rounds up to 480, whose encoding is the NaN; it saturates.
+    float8_e4m3fn carry = float8_e4m3fn::from_float(472.0f);
+
+    // OCP E2M1 has neither: 0x7 is 6, and NaN or overflow saturate.
+    float4_e2m1fn six = float4_e2m1fn::from_float(6.0f);
+    float4_e2m1fn sum = six;
+    sum.add(six, RoundingMode::NearestEven);
+    // 5 is halfway between 4 and 6; ties go to the even mantissa.
+    float4_e2m1fn five = float4_e2m1fn::from_float(5.0f);
+
+    // A block whose largest value is 6 keeps it unscaled.
+    binary32 in[2] = {binary32{6.0f}, binary32{-0.5f}};
+    mxfp4 block = mxfp4::quantise(in, 2);
+
+    MANTISSA_VALIDATE(largest.representation == 0x7e && largest.to_float() == 448.0f
+                      && top_binade.representation == 0x78
+                      && overflow.representation == 0x7e
+                      && infinity.representation == 0xfe
+                      && not_a_number.representation == 0x7f
+                      && carry.representation == 0x7e
+                      && six.representation == 0x7 && six.to_float() == 6.0f
+                      && sum.representation == 0x7
+                      && five.representation == 0x6
+                      && block.scale_exponent() == 0
+                      && block.elements[0].representation == 0x7
+                      && block.elements[1].representation == 0x9);
+}
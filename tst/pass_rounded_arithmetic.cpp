@@ -0,0 +1,49 @@
+#include <mantissa.h>
+#include <cmath>
+
+#include "hardware_float.h"
+
+int main() {
+    // Rounding to nearest, ties to even, should match the hardware
+    // bit-for-bit, subnormals and overflow included.
+    CounterRNG rng{7};
+    for (u64 i = 0; i < 100000; ++i) {
+        u32 lhs_bits{};
+        u32 rhs_bits{};
+        random_operands(rng, i, lhs_bits, rhs_bits);
+        float lhs = float_from_bits(lhs_bits);
+        float rhs = float_from_bits(rhs_bits);
+        if (lhs != lhs || rhs != rhs) continue;
+
+        binary32 sum{bits_from_float(lhs)};
+        sum.add(binary32{bits_from_float(rhs)}, RoundingMode::NearestEven);
+        binary32 difference{bits_from_float(lhs)};
+        difference.sub(binary32{bits_from_float(rhs)}, RoundingMode::NearestEven);
+        binary32 product{bits_from_float(lhs)};
+        product.mul(binary32{bits_from_float(rhs)}, RoundingMode::NearestEven);
+
+        if (sum.representation != bits_from_float(lhs + rhs)) return -1;
+        if (difference.representation != bits_from_float(lhs - rhs)) return -1;
+        if (product.representation != bits_from_float(lhs * rhs)) return -1;
+    }
+    // Fused multiply-add rounds once, so binary64 must match std::fma
+    // even when the addend cancels most of the product.
+    for (u64 i = 0; i < 100000; ++i) {
+        double lhs = double_from_bits((rng(3 * i) & 0x800fffffffffffff) | 0x3fe0000000000000);
+        double rhs = double_from_bits((rng(3 * i + 1) & 0x800fffffffffffff) | 0x3fe0000000000000);
+        u64 addend_bits = rng(3 * i + 2);
+        double addend = double_from_bits((addend_bits & 0x800fffffffffffff) | (u64(0x3c0 + (addend_bits >> 58)) << 52));
+        if (i & 1) addend = -(lhs * rhs);
+        binary64 result{bits_from_double(addend)};
+        result.fused_multiply_add(binary64{bits_from_double(lhs)}, binary64{bits_from_double(rhs)});
+        if (result.representation != bits_from_double(std::fma(lhs, rhs, addend))) return -1;
+    }
+
+    // Invalid operations give the canonical quiet NaN.
+    binary32 not_a_number{u32(0x7f800000)};
+    not_a_number.sub(binary32{u32(0x7f800000)}, RoundingMode::NearestEven);
+    binary64 zero_times_infinity{u64(0)};
+    zero_times_infinity.mul(binary64{u64(0x7ff0000000000000)}, RoundingMode::NearestEven);
+    MANTISSA_VALIDATE(not_a_number.representation == 0x7fc00000
+                      && zero_times_infinity.representation == 0x7ff8000000000000);
+}
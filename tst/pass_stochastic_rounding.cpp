@@ -0,0 +1,27 @@
+#include <mantissa.h>
+
+int main() {
+    // A quarter of an ULP above 1.0 in bfloat16 should round up a
+    // quarter of the time, and the same seed should always give the
+    // same results.
+    static constexpr size_t count = 1 << 16;
+    static binary32 in[count];
+    static bfloat16 out[count];
+    static bfloat16 again[count];
+    for (auto& value : in) value = binary32{1.0f + 0x1p-9f};
+
+    CounterRNG rng{42};
+    convert(in, out, count, RoundingMode::Stochastic, rng);
+    // Convert again in two chunks; each chunk passes its own offset.
+    convert(in, again, count / 2, RoundingMode::Stochastic, rng);
+    convert(in + count / 2, again + count / 2, count / 2, RoundingMode::Stochastic, rng, count / 2);
+
+    size_t rounded_up = 0;
+    bool reproducible = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (out[i].representation == 0x3f81) ++rounded_up;
+        else if (out[i].representation != 0x3f80) return -1;
+        if (out[i].representation != again[i].representation) reproducible = false;
+    }
+    MANTISSA_VALIDATE(reproducible && rounded_up > count / 4 - count / 64 && rounded_up < count / 4 + count / 64);
+}